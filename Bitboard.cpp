@@ -0,0 +1,252 @@
+#include "Bitboard.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define BITBOARD_AVX2
+#include <immintrin.h>
+#endif
+
+sMagic RookMagics[64];
+sMagic BishopMagics[64];
+
+// Shared attack tables, every square points into its own slice
+// Sizes are the sum of 2^(relevant blockers) over all squares
+static Bitboard RookTable[0x19000];
+static Bitboard BishopTable[0x1480];
+
+Bitboard BetweenTable[64][64];
+Bitboard LineTable[64][64];
+
+// Ray directions as (x, y) steps
+static const int rookDirs[4][2] = { { 0, -1 }, { 1, 0 }, { 0, 1 }, { -1, 0 } };
+static const int bishopDirs[4][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+
+// Slow ray walk, only used to fill the tables
+static Bitboard slidingAttack(const int dirs[4][2], int sq, Bitboard occupied) {
+	Bitboard attacks = 0;
+
+	for (int d = 0; d < 4; d++) {
+		int x = (sq & 7) + dirs[d][0];
+		int y = (sq >> 3) + dirs[d][1];
+
+		while (x >= 0 && x < 8 && y >= 0 && y < 8) {
+			Bitboard b = SquareBB(y * 8 + x);
+			attacks |= b;
+
+			// Stop at first blocker
+			if (occupied & b)
+				break;
+
+			x += dirs[d][0];
+			y += dirs[d][1];
+		}
+	}
+
+	return attacks;
+}
+
+// xorshift64* generator, reseeded per rank so the tables are the same every run
+// Seeds are ones known to find every magic of their rank quickly
+static const uint64_t rankSeeds[8] = { 728, 10316, 55013, 32803, 12281, 15100, 16645, 255 };
+static uint64_t randState = 1;
+
+static uint64_t random64() {
+	randState ^= randState >> 12;
+	randState ^= randState << 25;
+	randState ^= randState >> 27;
+	return randState * 2685821657736338717ULL;
+}
+
+// Magics with few set bits are found much faster
+static uint64_t sparseRandom64() {
+	return random64() & random64() & random64();
+}
+
+static void initMagics(const int dirs[4][2], sMagic* magics, Bitboard* table) {
+	Bitboard occupancy[4096];
+	Bitboard reference[4096];
+	int epoch[4096] = { 0 };
+	int attempt = 0;
+
+	for (int sq = 0; sq < 64; sq++) {
+		sMagic& m = magics[sq];
+
+		// Board edges are never relevant blockers unless the piece is on that edge
+		Bitboard edges = ((RANK_1 | RANK_8) & ~(RANK_1 << (8 * (sq >> 3))))
+			| ((FILE_A | FILE_H) & ~(FILE_A << (sq & 7)));
+
+		m.mask = slidingAttack(dirs, sq, 0) & ~edges;
+		m.shift = 64 - PopCount(m.mask);
+		m.attacks = (sq == 0) ? table : magics[sq - 1].attacks + (1ULL << (64 - magics[sq - 1].shift));
+
+		// Enumerate every subset of the mask (Carry-Rippler) with its true attack set
+		int size = 0;
+		Bitboard b = 0;
+		do {
+			occupancy[size] = b;
+			reference[size] = slidingAttack(dirs, sq, b);
+			size++;
+			b = (b - m.mask) & m.mask;
+		} while (b);
+
+		randState = rankSeeds[sq >> 3];
+
+		// Try random magics until every subset maps to a slot without a destructive collision
+		for (int i = 0; i < size; ) {
+			m.magic = 0;
+			while (PopCount((m.mask * m.magic) >> 56) < 6)
+				m.magic = sparseRandom64();
+
+			attempt++;
+			for (i = 0; i < size; i++) {
+				unsigned idx = m.index(occupancy[i]);
+
+				if (epoch[idx] < attempt) {
+					epoch[idx] = attempt;
+					m.attacks[idx] = reference[i];
+				}
+				else if (m.attacks[idx] != reference[i])
+					break;
+			}
+		}
+	}
+}
+
+// ######################### SET-WISE SLIDERS ######################### //
+// Kogge-Stone occluded fill, the sliders spread through empty squares in 3 doubling steps
+// A step off the side of the board wraps to the opposite file, so that file is masked out
+
+static inline Bitboard fillUp(Bitboard gen, Bitboard empty, int shift, Bitboard wrap) {
+	Bitboard pro = empty & wrap;
+
+	gen |= pro & (gen << shift);
+	pro &= pro << shift;
+	gen |= pro & (gen << (shift * 2));
+	pro &= pro << (shift * 2);
+	gen |= pro & (gen << (shift * 4));
+
+	return (gen << shift) & wrap;
+}
+
+static inline Bitboard fillDown(Bitboard gen, Bitboard empty, int shift, Bitboard wrap) {
+	Bitboard pro = empty & wrap;
+
+	gen |= pro & (gen >> shift);
+	pro &= pro >> shift;
+	gen |= pro & (gen >> (shift * 2));
+	pro &= pro >> (shift * 2);
+	gen |= pro & (gen >> (shift * 4));
+
+	return (gen >> shift) & wrap;
+}
+
+static Bitboard slidingAttacksPortable(Bitboard rooks, Bitboard bishops, Bitboard occupied) {
+	Bitboard empty = ~occupied;
+
+	return fillUp(rooks, empty, 1, ~FILE_A) | fillUp(rooks, empty, 8, ~0ULL)
+		| fillDown(rooks, empty, 1, ~FILE_H) | fillDown(rooks, empty, 8, ~0ULL)
+		| fillUp(bishops, empty, 9, ~FILE_A) | fillUp(bishops, empty, 7, ~FILE_H)
+		| fillDown(bishops, empty, 9, ~FILE_H) | fillDown(bishops, empty, 7, ~FILE_A);
+}
+
+#if defined(BITBOARD_AVX2)
+
+// Same fill with the 4 upward directions in one register and the 4 downward in another
+// Lanes are (x + 1), (y + 1), (x + 1, y + 1) and (x - 1, y + 1), each with its own shift and wrap mask
+#if defined(__GNUC__)
+__attribute__((target("avx2")))
+#endif
+static Bitboard slidingAttacksAvx2(Bitboard rooks, Bitboard bishops, Bitboard occupied) {
+	const __m256i shift1 = _mm256_set_epi64x(7, 9, 8, 1);
+	const __m256i shift2 = _mm256_add_epi64(shift1, shift1);
+	const __m256i shift4 = _mm256_add_epi64(shift2, shift2);
+	const __m256i wrapUp = _mm256_set_epi64x((long long)~FILE_H, (long long)~FILE_A, -1LL, (long long)~FILE_A);
+	const __m256i wrapDown = _mm256_set_epi64x((long long)~FILE_A, (long long)~FILE_H, -1LL, (long long)~FILE_H);
+
+	__m256i empty = _mm256_set1_epi64x((long long)~occupied);
+	__m256i sliders = _mm256_set_epi64x((long long)bishops, (long long)bishops, (long long)rooks, (long long)rooks);
+
+	// Upward
+	__m256i gen = sliders;
+	__m256i pro = _mm256_and_si256(empty, wrapUp);
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift1)));
+	pro = _mm256_and_si256(pro, _mm256_sllv_epi64(pro, shift1));
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift2)));
+	pro = _mm256_and_si256(pro, _mm256_sllv_epi64(pro, shift2));
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_sllv_epi64(gen, shift4)));
+	__m256i attacks = _mm256_and_si256(_mm256_sllv_epi64(gen, shift1), wrapUp);
+
+	// Downward
+	gen = sliders;
+	pro = _mm256_and_si256(empty, wrapDown);
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift1)));
+	pro = _mm256_and_si256(pro, _mm256_srlv_epi64(pro, shift1));
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift2)));
+	pro = _mm256_and_si256(pro, _mm256_srlv_epi64(pro, shift2));
+	gen = _mm256_or_si256(gen, _mm256_and_si256(pro, _mm256_srlv_epi64(gen, shift4)));
+	attacks = _mm256_or_si256(attacks, _mm256_and_si256(_mm256_srlv_epi64(gen, shift1), wrapDown));
+
+	// Fold the 4 lanes into one set
+	__m128i half = _mm_or_si128(_mm256_castsi256_si128(attacks), _mm256_extracti128_si256(attacks, 1));
+	return (Bitboard)(_mm_cvtsi128_si64(half) | _mm_extract_epi64(half, 1));
+}
+
+// AVX2 needs both the CPU instructions and the OS saving the wide registers
+static bool cpuHasAvx2() {
+#if defined(_MSC_VER)
+	int info[4];
+
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+
+	__cpuid(info, 1);
+	if (!(info[2] & (1 << 27)) || !(info[2] & (1 << 28)) || (_xgetbv(0) & 6) != 6)
+		return false;
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+// Picked once by InitBitboards, the portable kernel is always safe to call
+static Bitboard (*slidingKernel)(Bitboard, Bitboard, Bitboard) = slidingAttacksPortable;
+
+Bitboard SlidingAttacksBy(Bitboard rooks, Bitboard bishops, Bitboard occupied) {
+	return slidingKernel(rooks, bishops, occupied);
+}
+
+// ######################### INIT ##################################### //
+
+void InitBitboards() {
+#if defined(BITBOARD_AVX2)
+	if (cpuHasAvx2())
+		slidingKernel = slidingAttacksAvx2;
+#endif
+
+	initMagics(rookDirs, RookMagics, RookTable);
+	initMagics(bishopDirs, BishopMagics, BishopTable);
+
+	// Lines are taken from the slider attacks of both end squares
+	for (int s1 = 0; s1 < 64; s1++) {
+		for (int s2 = 0; s2 < 64; s2++) {
+			BetweenTable[s1][s2] = 0;
+			LineTable[s1][s2] = 0;
+
+			if (s1 == s2)
+				continue;
+
+			if (RookAttacks(s1, 0) & SquareBB(s2)) {
+				LineTable[s1][s2] = (RookAttacks(s1, 0) & RookAttacks(s2, 0)) | SquareBB(s1) | SquareBB(s2);
+				BetweenTable[s1][s2] = RookAttacks(s1, SquareBB(s2)) & RookAttacks(s2, SquareBB(s1));
+			}
+			else if (BishopAttacks(s1, 0) & SquareBB(s2)) {
+				LineTable[s1][s2] = (BishopAttacks(s1, 0) & BishopAttacks(s2, 0)) | SquareBB(s1) | SquareBB(s2);
+				BetweenTable[s1][s2] = BishopAttacks(s1, SquareBB(s2)) & BishopAttacks(s2, SquareBB(s1));
+			}
+		}
+	}
+}
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 64-bit occupancy set, one bit per board square
+// Bit index is the same square index used by the rest of the game (y * 8 + x)
+typedef uint64_t Bitboard;
+
+// ######################### TYPES #################################### //
+
+// Piece types, shared by the board, the moves, the pieces and the game
+enum pieceType {
+	PAWN,
+	ROOK,
+	KNIGHT,
+	BISHOP,
+	QUEEN,
+	KING
+};
+
+// Material values in centipawns, indexed by pieceType
+// King is worth more than everything else together so exchanges never give it up
+inline constexpr int PieceValue[6] = { 100, 500, 320, 330, 900, 20000 };
+
+// Player colors (PLAYER 1 is White, PLAYER 2 is Black)
+enum playerColor {
+	WHITE,
+	BLACK
+};
+
+// ######################### CONSTANTS ################################ //
+
+const Bitboard FILE_A = 0x0101010101010101ULL;
+const Bitboard FILE_B = FILE_A << 1;
+const Bitboard FILE_G = FILE_A << 6;
+const Bitboard FILE_H = FILE_A << 7;
+
+const Bitboard RANK_1 = 0xFFULL;
+const Bitboard RANK_2 = RANK_1 << (8 * 1);
+const Bitboard RANK_7 = RANK_1 << (8 * 6);
+const Bitboard RANK_8 = RANK_1 << (8 * 7);
+
+// ######################### HELPERS ################################## //
+
+// Single square set
+inline Bitboard SquareBB(int sq) {
+	return 1ULL << sq;
+}
+
+// Number of squares in set
+inline int PopCount(Bitboard b) {
+#if defined(_MSC_VER)
+	return (int)__popcnt64(b);
+#else
+	return __builtin_popcountll(b);
+#endif
+}
+
+// Lowest square in set (set must not be empty)
+inline int Lsb(Bitboard b) {
+#if defined(_MSC_VER)
+	unsigned long idx;
+	_BitScanForward64(&idx, b);
+	return (int)idx;
+#else
+	return __builtin_ctzll(b);
+#endif
+}
+
+// Remove and return lowest square in set
+inline int PopLsb(Bitboard& b) {
+	int sq = Lsb(b);
+	b &= b - 1;
+	return sq;
+}
+
+inline bool MoreThanOne(Bitboard b) {
+	return (b & (b - 1)) != 0;
+}
+
+// ######################### LEAPER ATTACKS ########################### //
+
+// Steps as (x, y), steps that leave the board are dropped
+// Player 1 (White) pawns move towards y + 1, Player 2 (Black) towards y - 1
+inline constexpr int knightSteps[8][2] = { { -1, -2 }, { 1, -2 }, { 2, -1 }, { 2, 1 }, { 1, 2 }, { -1, 2 }, { -2, 1 }, { -2, -1 } };
+inline constexpr int kingSteps[8][2] = { { 0, -1 }, { 1, -1 }, { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 } };
+inline constexpr int pawnSteps[2][2][2] = { { { -1, 1 }, { 1, 1 } }, { { -1, -1 }, { 1, -1 } } };
+
+constexpr Bitboard StepAttacks(int sq, const int steps[][2], int count) {
+	Bitboard attacks = 0;
+
+	for (int i = 0; i < count; i++) {
+		int x = (sq & 7) + steps[i][0];
+		int y = (sq >> 3) + steps[i][1];
+
+		// Bounds check here is the only place edge wrap-around is handled
+		if (x >= 0 && x < 8 && y >= 0 && y < 8)
+			attacks |= 1ULL << (y * 8 + x);
+	}
+
+	return attacks;
+}
+
+constexpr std::array<Bitboard, 64> MakeLeaperTable(const int steps[][2], int count) {
+	std::array<Bitboard, 64> table = {};
+
+	for (int sq = 0; sq < 64; sq++)
+		table[sq] = StepAttacks(sq, steps, count);
+
+	return table;
+}
+
+// Tables are generated by the compiler
+inline constexpr std::array<Bitboard, 64> KnightTable = MakeLeaperTable(knightSteps, 8);
+inline constexpr std::array<Bitboard, 64> KingTable = MakeLeaperTable(kingSteps, 8);
+inline constexpr std::array<Bitboard, 64> PawnTable[2] = { MakeLeaperTable(pawnSteps[0], 2), MakeLeaperTable(pawnSteps[1], 2) };
+
+// Corners and edges must not wrap to the other side of the board
+static_assert(KnightTable[0] == 0x20400ULL, "Knight a1");
+static_assert(KnightTable[63] == 0x20400000000000ULL, "Knight h8");
+static_assert(KnightTable[7] == 0x402000ULL, "Knight h1");
+static_assert(KingTable[0] == 0x302ULL, "King a1");
+static_assert(KingTable[15] == 0xC040C0ULL, "King h2");
+static_assert(PawnTable[0][8] == 0x20000ULL, "White pawn a2");
+static_assert(PawnTable[1][55] == 0x400000000000ULL, "Black pawn h7");
+static_assert(PawnTable[0][63] == 0, "White pawn h8");
+
+inline Bitboard KnightAttacks(int sq) {
+	return KnightTable[sq];
+}
+
+inline Bitboard KingAttacks(int sq) {
+	return KingTable[sq];
+}
+
+// Squares a pawn of color attacks diagonally
+inline Bitboard PawnAttacks(int color, int sq) {
+	return PawnTable[color][sq];
+}
+
+// ######################### SLIDING ATTACKS ########################## //
+
+// Magic bitboard entry for one square
+// Relevant blockers (mask) are hashed by a multiply and shift into that square's slice of the attack table
+struct sMagic {
+	Bitboard mask;
+	Bitboard magic;
+	Bitboard* attacks;
+	int shift;
+
+	unsigned index(Bitboard occupied) const {
+		return (unsigned)(((occupied & mask) * magic) >> shift);
+	}
+};
+
+extern sMagic RookMagics[64];
+extern sMagic BishopMagics[64];
+
+// Builds the magic and line tables, must be called once at startup before any attack lookup
+void InitBitboards();
+
+// Full attack set of a slider on sq for the given occupancy (blockers are included)
+inline Bitboard RookAttacks(int sq, Bitboard occupied) {
+	return RookMagics[sq].attacks[RookMagics[sq].index(occupied)];
+}
+
+inline Bitboard BishopAttacks(int sq, Bitboard occupied) {
+	return BishopMagics[sq].attacks[BishopMagics[sq].index(occupied)];
+}
+
+inline Bitboard QueenAttacks(int sq, Bitboard occupied) {
+	return RookAttacks(sq, occupied) | BishopAttacks(sq, occupied);
+}
+
+// Squares a piece of any type attacks from sq
+inline Bitboard AttacksFrom(int type, int color, int sq, Bitboard occupied) {
+	switch (type) {
+	case PAWN:		return PawnAttacks(color, sq);
+	case ROOK:		return RookAttacks(sq, occupied);
+	case KNIGHT:	return KnightAttacks(sq);
+	case BISHOP:	return BishopAttacks(sq, occupied);
+	case QUEEN:		return QueenAttacks(sq, occupied);
+	case KING:		return KingAttacks(sq);
+	}
+
+	return 0;
+}
+
+// ######################### SET-WISE ATTACKS ######################### //
+// Attacks of a whole set of pieces at once, found by shifting the set instead of a lookup per square
+
+inline Bitboard PawnAttacksBy(int color, Bitboard pawns) {
+	return (color == WHITE)
+		? ((pawns & ~FILE_A) << 7) | ((pawns & ~FILE_H) << 9)
+		: ((pawns & ~FILE_A) >> 9) | ((pawns & ~FILE_H) >> 7);
+}
+
+inline Bitboard KnightAttacksBy(Bitboard knights) {
+	Bitboard one = ((knights >> 1) & ~FILE_H) | ((knights << 1) & ~FILE_A);
+	Bitboard two = ((knights >> 2) & ~(FILE_G | FILE_H)) | ((knights << 2) & ~(FILE_A | FILE_B));
+
+	return (one << 16) | (one >> 16) | (two << 8) | (two >> 8);
+}
+
+inline Bitboard KingAttacksBy(Bitboard kings) {
+	Bitboard row = ((kings >> 1) & ~FILE_H) | ((kings << 1) & ~FILE_A);
+	kings |= row;
+
+	return row | (kings << 8) | (kings >> 8);
+}
+
+// Squares attacked by every rook-like and every bishop-like slider together
+// Kogge-Stone fills spread all 8 directions at once, 4 per register on CPUs with AVX2
+Bitboard SlidingAttacksBy(Bitboard rooks, Bitboard bishops, Bitboard occupied);
+
+// ######################### LINES #################################### //
+
+extern Bitboard BetweenTable[64][64];
+extern Bitboard LineTable[64][64];
+
+// Squares strictly between two squares on a shared line, empty if not aligned
+inline Bitboard BetweenBB(int s1, int s2) {
+	return BetweenTable[s1][s2];
+}
+
+// Whole board line through two squares (edge to edge), empty if not aligned
+inline Bitboard LineBB(int s1, int s2) {
+	return LineTable[s1][s2];
+}
@@ -0,0 +1,582 @@
+#include <cctype>
+#include <sstream>
+#include "Board.h"
+
+// Castling rights kept when a move touches a square
+// A king or rook leaving its starting square (or a rook being captured there) loses the matching rights
+static constexpr std::array<int, 64> MakeCastleMask() {
+	std::array<int, 64> mask = {};
+
+	for (int sq = 0; sq < 64; sq++)
+		mask[sq] = WHITE_OO | WHITE_OOO | BLACK_OO | BLACK_OOO;
+
+	mask[0] &= ~WHITE_OOO;
+	mask[4] &= ~(WHITE_OO | WHITE_OOO);
+	mask[7] &= ~WHITE_OO;
+	mask[56] &= ~BLACK_OOO;
+	mask[60] &= ~(BLACK_OO | BLACK_OOO);
+	mask[63] &= ~BLACK_OO;
+
+	return mask;
+}
+
+static constexpr std::array<int, 64> castleMask = MakeCastleMask();
+
+// Zobrist keys, one random number per (color, type, square), castling rights set and en passant file
+// Generated by the compiler with splitmix64 so every build hashes the same
+struct sZobristKeys {
+	uint64_t pieces[2][6][64];
+	uint64_t side;
+	uint64_t castle[16];
+	uint64_t epFile[8];
+};
+
+static constexpr uint64_t SplitMix64(uint64_t& state) {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static constexpr sZobristKeys MakeZobristKeys() {
+	sZobristKeys keys = {};
+	uint64_t state = 0x2545F4914F6CDD1DULL;
+
+	for (int c = 0; c < 2; c++)
+		for (int t = 0; t < 6; t++)
+			for (int sq = 0; sq < 64; sq++)
+				keys.pieces[c][t][sq] = SplitMix64(state);
+
+	keys.side = SplitMix64(state);
+
+	for (int i = 0; i < 16; i++)
+		keys.castle[i] = SplitMix64(state);
+
+	for (int i = 0; i < 8; i++)
+		keys.epFile[i] = SplitMix64(state);
+
+	return keys;
+}
+
+static constexpr sZobristKeys Zobrist = MakeZobristKeys();
+
+cBoard::cBoard() {
+	tracking = false;
+	clear();
+}
+
+void cBoard::clear() {
+	for (int i = 0; i < 6; i++)
+		pieces[i] = 0;
+
+	colors[WHITE] = 0;
+	colors[BLACK] = 0;
+	occupied = 0;
+
+	sideToMove = WHITE;
+	castleRights = 0;
+	epSquare = -1;
+	halfmoveClock = 0;
+
+	historyCount = 0;
+	ply = 0;
+
+	for (int sq = 0; sq < 64; sq++)
+		mailbox[sq] = NO_PIECE;
+
+	for (int t = 0; t < 6; t++) {
+		pieceCount[WHITE][t] = 0;
+		pieceCount[BLACK][t] = 0;
+	}
+
+	// Tracking stays on, the maps fill back up as pieces are added
+	for (int sq = 0; sq < 64; sq++) {
+		attackCount[WHITE][sq] = 0;
+		attackCount[BLACK][sq] = 0;
+	}
+	attacks[WHITE] = 0;
+	attacks[BLACK] = 0;
+
+	key = computeKey();
+}
+
+void cBoard::setStartPosition() {
+	clear();
+
+	// Back rank order from x = 0 to x = 7
+	const int backRank[8] = { ROOK, KNIGHT, BISHOP, QUEEN, KING, BISHOP, KNIGHT, ROOK };
+
+	for (int x = 0; x < 8; x++) {
+		// Player 1 (White) on top rows
+		addPiece(WHITE, backRank[x], x);
+		addPiece(WHITE, PAWN, 8 + x);
+
+		// Player 2 (Black) on bottom rows
+		addPiece(BLACK, PAWN, 48 + x);
+		addPiece(BLACK, backRank[x], 56 + x);
+	}
+
+	castleRights = WHITE_OO | WHITE_OOO | BLACK_OO | BLACK_OOO;
+	key = computeKey();
+}
+
+// Loads a position in Forsyth-Edwards Notation
+// FEN lists rank 8 first, which is the bottom row (y = 7) of this board
+// Returns false and leaves the board cleared if the piece placement is malformed
+bool cBoard::setFen(const std::string& fen) {
+	clear();
+
+	std::istringstream ss(fen);
+	std::string placement, side, castling, ep;
+	ss >> placement >> side >> castling >> ep >> halfmoveClock;
+
+	const std::string pieceChars = "prnbqk";
+	int x = 0;
+	int y = 7;
+
+	for (char c : placement) {
+		if (c == '/') {
+			x = 0;
+			y--;
+		}
+		else if (c >= '1' && c <= '8')
+			x += c - '0';
+		else {
+			size_t type = pieceChars.find((char)tolower(c));
+			if (type == std::string::npos || x > 7 || y < 0) {
+				clear();
+				return false;
+			}
+
+			addPiece(isupper(c) ? WHITE : BLACK, (int)type, y * 8 + x);
+			x++;
+		}
+	}
+
+	sideToMove = (side == "b") ? BLACK : WHITE;
+
+	for (char c : castling) {
+		switch (c) {
+		case 'K': castleRights |= WHITE_OO; break;
+		case 'Q': castleRights |= WHITE_OOO; break;
+		case 'k': castleRights |= BLACK_OO; break;
+		case 'q': castleRights |= BLACK_OOO; break;
+		}
+	}
+
+	// A right only stands with its king and rook still on their home squares
+	const int rights[4] = { WHITE_OO, WHITE_OOO, BLACK_OO, BLACK_OOO };
+	const int rookHome[4] = { 7, 0, 63, 56 };
+
+	for (int i = 0; i < 4; i++) {
+		int color = i / 2;
+		int kingHome = (color == WHITE) ? 4 : 60;
+
+		if (!(piecesOf(color, KING) & SquareBB(kingHome)) || !(piecesOf(color, ROOK) & SquareBB(rookHome[i])))
+			castleRights &= ~rights[i];
+	}
+
+	// En passant square is behind a pawn that just moved two squares, rank 6 with White to move and rank 3 with Black
+	if (ep != "-" && !ep.empty()) {
+		char epRank = (sideToMove == WHITE) ? '6' : '3';
+		if (ep.size() != 2 || ep[0] < 'a' || ep[0] > 'h' || ep[1] != epRank) {
+			clear();
+			return false;
+		}
+
+		epSquare = (ep[0] - 'a') + (ep[1] - '1') * 8;
+	}
+
+	key = computeKey();
+
+	return true;
+}
+
+// ######################### PLACEMENT ################################ //
+
+void cBoard::addPiece(int color, int type, int sq) {
+	Bitboard b = SquareBB(sq);
+
+	// Rays through sq are cut short once it is filled
+	Bitboard sliders = tracking ? slidersTo(sq) : 0;
+	countSliders(sliders, -1);
+
+	pieces[type] |= b;
+	colors[color] |= b;
+	occupied |= b;
+	mailbox[sq] = PieceCode(color, type);
+	pieceCount[color][type]++;
+
+	if (tracking) {
+		countSliders(sliders, 1);
+		countAttacks(color, AttacksFrom(type, color, sq, occupied), 1);
+	}
+
+	key ^= Zobrist.pieces[color][type][sq];
+}
+
+void cBoard::removePiece(int sq) {
+	int type = typeOn(sq);
+	int color = colorOn(sq);
+
+	// Nothing to remove
+	if (type < 0)
+		return;
+
+	// Rays through sq reach further once it is empty
+	Bitboard sliders = 0;
+	if (tracking) {
+		sliders = slidersTo(sq);
+		countAttacks(color, AttacksFrom(type, color, sq, occupied), -1);
+		countSliders(sliders, -1);
+	}
+
+	Bitboard b = ~SquareBB(sq);
+
+	pieces[type] &= b;
+	colors[color] &= b;
+	occupied &= b;
+	mailbox[sq] = NO_PIECE;
+	pieceCount[color][type]--;
+
+	countSliders(sliders, 1);
+
+	key ^= Zobrist.pieces[color][type][sq];
+}
+
+void cBoard::movePiece(int from, int to) {
+	int type = typeOn(from);
+	int color = colorOn(from);
+
+	// Nothing to move
+	if (type < 0)
+		return;
+
+	// Captured piece is removed before placing the moving piece
+	removePiece(to);
+	removePiece(from);
+	addPiece(color, type, to);
+}
+
+void cBoard::makeMove(Move m) {
+	if (sideToMove == WHITE)
+		doMove<WHITE>(m);
+	else
+		doMove<BLACK>(m);
+}
+
+void cBoard::unmakeMove() {
+	if (historyCount == 0)
+		return;
+
+	ply--;
+	historyCount--;
+
+	sideToMove ^= 1;
+
+	if (sideToMove == WHITE)
+		undoMove<WHITE>(history[ply % MAX_HISTORY]);
+	else
+		undoMove<BLACK>(history[ply % MAX_HISTORY]);
+}
+
+// Us is the side playing the move, its pawn direction and colors are folded by the compiler
+template<int Us>
+void cBoard::doMove(Move m) {
+	constexpr int up = (Us == WHITE) ? 8 : -8;
+
+	int from = MoveFrom(m);
+	int to = MoveTo(m);
+	int moved = typeOn(from);
+
+	// Save what the move destroys
+	sUndo& undo = history[ply % MAX_HISTORY];
+	undo.key = key;
+	undo.move = m;
+	undo.captured = (int8_t)((MoveFlags(m) == EN_PASSANT) ? PAWN : typeOn(to));
+	undo.castleRights = (int8_t)castleRights;
+	undo.epSquare = (int8_t)epSquare;
+	undo.halfmoveClock = (int16_t)halfmoveClock;
+
+	ply++;
+	if (historyCount < MAX_HISTORY)
+		historyCount++;
+
+	// Old rights and en passant file leave the key, pieces update it as they move
+	key ^= Zobrist.castle[castleRights];
+	if (epSquare >= 0)
+		key ^= Zobrist.epFile[epSquare & 7];
+
+	switch (MoveFlags(m)) {
+	// Captured pawn is behind the destination square
+	case EN_PASSANT:
+		removePiece(to - up);
+		movePiece(from, to);
+		break;
+
+	// Rook jumps over the king
+	case CASTLE_KING:
+		movePiece(from, to);
+		movePiece(to + 1, to - 1);
+		break;
+
+	case CASTLE_QUEEN:
+		movePiece(from, to);
+		movePiece(to - 2, to + 1);
+		break;
+
+	default:
+		movePiece(from, to);
+
+		// Pawn is replaced by the promoted piece
+		if (IsPromotion(m)) {
+			removePiece(to);
+			addPiece(Us, PromotionType(m), to);
+		}
+	}
+
+	// Captures and pawn moves are irreversible
+	halfmoveClock = (moved == PAWN || undo.captured >= 0) ? 0 : halfmoveClock + 1;
+
+	// Square skipped by a double push can be captured on next turn only
+	epSquare = (MoveFlags(m) == DOUBLE_PUSH) ? from + up : -1;
+	castleRights &= castleMask[from] & castleMask[to];
+
+	key ^= Zobrist.castle[castleRights];
+	if (epSquare >= 0)
+		key ^= Zobrist.epFile[epSquare & 7];
+
+	sideToMove = Us ^ 1;
+	key ^= Zobrist.side;
+}
+
+template<int Us>
+void cBoard::undoMove(const sUndo& undo) {
+	constexpr int up = (Us == WHITE) ? 8 : -8;
+
+	int from = MoveFrom(undo.move);
+	int to = MoveTo(undo.move);
+
+	switch (MoveFlags(undo.move)) {
+	case EN_PASSANT:
+		movePiece(to, from);
+		addPiece(Us ^ 1, PAWN, to - up);
+		break;
+
+	case CASTLE_KING:
+		movePiece(to, from);
+		movePiece(to - 1, to + 1);
+		break;
+
+	case CASTLE_QUEEN:
+		movePiece(to, from);
+		movePiece(to + 1, to - 2);
+		break;
+
+	default:
+		// Promoted piece turns back into a pawn
+		if (IsPromotion(undo.move)) {
+			removePiece(to);
+			addPiece(Us, PAWN, from);
+		}
+		else
+			movePiece(to, from);
+
+		if (undo.captured >= 0)
+			addPiece(Us ^ 1, undo.captured, to);
+	}
+
+	castleRights = undo.castleRights;
+	epSquare = undo.epSquare;
+	halfmoveClock = undo.halfmoveClock;
+	key = undo.key;
+}
+
+// ######################### DRAWS #################################### //
+
+// Only every other earlier position has the same side to move
+// Captures and pawn moves can never be undone, so the walk back stops at the halfmove clock
+int cBoard::repetitions() const {
+	int count = 0;
+	int reach = (halfmoveClock < historyCount) ? halfmoveClock : historyCount;
+
+	for (int back = 4; back <= reach; back += 2)
+		if (history[(ply - back) % MAX_HISTORY].key == key)
+			count++;
+
+	return count;
+}
+
+// Neither side can ever mate, with only kings, a single minor piece or bishops all on one square color left
+bool cBoard::insufficientMaterial() const {
+	for (int c = 0; c < 2; c++)
+		if (pieceCount[c][PAWN] || pieceCount[c][ROOK] || pieceCount[c][QUEEN])
+			return false;
+
+	int knights = pieceCount[WHITE][KNIGHT] + pieceCount[BLACK][KNIGHT];
+	int bishops = pieceCount[WHITE][BISHOP] + pieceCount[BLACK][BISHOP];
+
+	if (knights + bishops <= 1)
+		return true;
+
+	// Light squares, a1 is dark
+	const Bitboard LIGHT_SQUARES = 0x55AA55AA55AA55AAULL;
+
+	return knights == 0 && (!(pieces[BISHOP] & LIGHT_SQUARES) || !(pieces[BISHOP] & ~LIGHT_SQUARES));
+}
+
+// ######################### ATTACK MAPS ############################## //
+
+void cBoard::trackAttacks(bool on) {
+	tracking = on;
+
+	if (!on)
+		return;
+
+	for (int sq = 0; sq < 64; sq++) {
+		attackCount[WHITE][sq] = 0;
+		attackCount[BLACK][sq] = 0;
+	}
+	attacks[WHITE] = 0;
+	attacks[BLACK] = 0;
+
+	for (Bitboard b = occupied; b; ) {
+		int sq = PopLsb(b);
+		int color = colorOn(sq);
+		countAttacks(color, AttacksFrom(typeOn(sq), color, sq, occupied), 1);
+	}
+}
+
+Bitboard cBoard::slidersTo(int sq) const {
+	return (BishopAttacks(sq, occupied) & (pieces[BISHOP] | pieces[QUEEN]))
+		| (RookAttacks(sq, occupied) & (pieces[ROOK] | pieces[QUEEN]));
+}
+
+void cBoard::countAttacks(int color, Bitboard targets, int delta) {
+	while (targets) {
+		int sq = PopLsb(targets);
+		attackCount[color][sq] += delta;
+
+		if (attackCount[color][sq])
+			attacks[color] |= SquareBB(sq);
+		else
+			attacks[color] &= ~SquareBB(sq);
+	}
+}
+
+// Adds or takes away each slider's attacks for the current occupancy
+void cBoard::countSliders(Bitboard sliders, int delta) {
+	while (sliders) {
+		int sq = PopLsb(sliders);
+		int color = colorOn(sq);
+		countAttacks(color, AttacksFrom(typeOn(sq), color, sq, occupied), delta);
+	}
+}
+
+// ######################### QUERIES ################################## //
+
+// Sliders see through any square missing from occupied
+Bitboard cBoard::attacksBy(int color, Bitboard occupied) const {
+	Bitboard queens = piecesOf(color, QUEEN);
+
+	return PawnAttacksBy(color, piecesOf(color, PAWN))
+		| KnightAttacksBy(piecesOf(color, KNIGHT))
+		| KingAttacksBy(piecesOf(color, KING))
+		| SlidingAttacksBy(piecesOf(color, ROOK) | queens, piecesOf(color, BISHOP) | queens, occupied);
+}
+
+bool cBoard::seeGE(Move m, int threshold) const {
+	// Castling never puts anything en prise
+	if (MoveFlags(m) == CASTLE_KING || MoveFlags(m) == CASTLE_QUEEN)
+		return threshold <= 0;
+
+	int from = MoveFrom(m);
+	int to = MoveTo(m);
+	Bitboard occ = occupied ^ SquareBB(from);
+
+	int victim = (MoveFlags(m) == EN_PASSANT) ? PAWN : typeOn(to);
+	if (MoveFlags(m) == EN_PASSANT)
+		occ ^= SquareBB(to ^ 8);
+
+	// What the mover is up after the capture, then what it is up if its piece is taken back
+	int swap = (victim >= 0 ? PieceValue[victim] : 0) - threshold;
+	if (swap < 0)
+		return false;
+
+	swap = PieceValue[typeOn(from)] - swap;
+	if (swap <= 0)
+		return true;
+
+	// Cheapest pieces recapture first
+	const int order[5] = { PAWN, KNIGHT, BISHOP, ROOK, QUEEN };
+	Bitboard diagonal = pieces[BISHOP] | pieces[QUEEN];
+	Bitboard straight = pieces[ROOK] | pieces[QUEEN];
+
+	Bitboard attackers = attackersTo(to, occ);
+	int stm = colorOn(from);
+	bool result = true;
+
+	while (true) {
+		stm ^= 1;
+		attackers &= occ;
+
+		Bitboard ours = attackers & colors[stm];
+		if (!ours)
+			break;
+
+		result = !result;
+
+		int type = KING;
+		for (int t : order) {
+			if (ours & pieces[t]) {
+				type = t;
+				break;
+			}
+		}
+
+		// A king can only take back if nothing is left to take it
+		if (type == KING)
+			return (attackers & colors[stm ^ 1]) ? !result : result;
+
+		swap = PieceValue[type] - swap;
+		if (swap < (int)result)
+			break;
+
+		// Removing the piece may uncover a slider behind it
+		occ ^= SquareBB(Lsb(ours & pieces[type]));
+		if (type == PAWN || type == BISHOP || type == QUEEN)
+			attackers |= BishopAttacks(to, occ) & diagonal;
+		if (type == ROOK || type == QUEEN)
+			attackers |= RookAttacks(to, occ) & straight;
+	}
+
+	return result;
+}
+
+// Returns square of player's king, -1 if there is none
+int cBoard::kingSquare(int color) const {
+	Bitboard king = piecesOf(color, KING);
+
+	return king ? Lsb(king) : -1;
+}
+
+uint64_t cBoard::computeKey() const {
+	uint64_t key = 0;
+
+	for (int c = 0; c < 2; c++) {
+		for (int t = 0; t < 6; t++) {
+			for (Bitboard b = piecesOf(c, t); b; )
+				key ^= Zobrist.pieces[c][t][PopLsb(b)];
+		}
+	}
+
+	if (sideToMove == BLACK)
+		key ^= Zobrist.side;
+
+	key ^= Zobrist.castle[castleRights];
+
+	if (epSquare >= 0)
+		key ^= Zobrist.epFile[epSquare & 7];
+
+	return key;
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <string>
+#include "Bitboard.h"
+#include "Move.h"
+
+// Castling rights, one bit each
+enum castleRight {
+	WHITE_OO = 0x1,
+	WHITE_OOO = 0x2,
+	BLACK_OO = 0x4,
+	BLACK_OOO = 0x8
+};
+
+// Mailbox piece codes, one byte per square
+//	bits 0 - 2 : pieceType + 1 (0 when the square is empty)
+//	bit 3      : White
+//	bit 4      : Black
+//	bit 5      : King
+// Ally, enemy and king tests are each a single mask test on the byte
+enum pieceCode {
+	NO_PIECE = 0x00,
+	CODE_TYPE = 0x07,
+	CODE_WHITE = 0x08,
+	CODE_BLACK = 0x10,
+	CODE_KING = 0x20
+};
+
+inline uint8_t ColorCode(int color) {
+	return (uint8_t)(CODE_WHITE << color);
+}
+
+inline uint8_t PieceCode(int color, int type) {
+	return (uint8_t)((type + 1) | ColorCode(color) | (type == KING ? CODE_KING : 0));
+}
+
+// Everything makeMove overwrites that cannot be worked out again from the move
+struct sUndo {
+	uint64_t key;
+	Move move;
+	int8_t captured;		// pieceType taken, -1 if none
+	int8_t castleRights;
+	int8_t epSquare;
+	int16_t halfmoveClock;
+};
+
+// Undo stack size, older moves than this cannot be taken back
+const int MAX_HISTORY = 1024;
+
+// BOARD
+// Position stored as occupancy sets, one per piece type and one per color
+// A piece of color c and type t on a square has that square's bit set in both pieces[t] and colors[c]
+class cBoard {
+public:
+	Bitboard pieces[6];
+	Bitboard colors[2];
+	Bitboard occupied;
+
+	// Piece code on each square, the whole board fits in one cache line
+	alignas(64) uint8_t mailbox[64];
+
+	int sideToMove;
+	int castleRights;
+	int epSquare;		// Square a pawn can capture en passant on, -1 if none
+	int halfmoveClock;	// Plies since the last capture or pawn move
+
+	// Number of pieces of each color and type, kept up to date by addPiece and removePiece
+	uint8_t pieceCount[2][6];
+
+	// Zobrist hash, kept up to date by every change to the board
+	uint64_t key;
+
+	// Number of pieces of each color attacking each square, and the squares attacked at least once
+	// Only kept up to date while tracking is on, boards used for search leave it off
+	uint8_t attackCount[2][64];
+	Bitboard attacks[2];
+
+	// Constructor
+	cBoard();
+
+	// Setup
+	void clear();
+	void setStartPosition();
+	bool setFen(const std::string& fen);
+
+	// Piece placement
+	void addPiece(int color, int type, int sq);
+	void removePiece(int sq);
+	void movePiece(int from, int to);
+
+	// Plays a move for the side to move and passes the turn
+	void makeMove(Move m);
+	// Takes back the last move played
+	void unmakeMove();
+	bool canUnmake() const { return historyCount > 0; }
+
+	// Queries
+	// typeOn and colorOn return -1 for an empty square
+	int typeOn(int sq) const { return (mailbox[sq] & CODE_TYPE) - 1; }
+	int colorOn(int sq) const { return mailbox[sq] ? (mailbox[sq] >> 4) & 1 : -1; }
+	bool isAlly(int sq, int color) const { return (mailbox[sq] & ColorCode(color)) != 0; }
+	bool isEnemy(int sq, int color) const { return (mailbox[sq] & ColorCode(color ^ 1)) != 0; }
+	bool isKing(int sq) const { return (mailbox[sq] & CODE_KING) != 0; }
+	int kingSquare(int color) const;
+	Bitboard piecesOf(int color, int type) const { return pieces[type] & colors[color]; }
+
+	// Pieces of both colors attacking sq, probed outwards from sq
+	// Sliders see through any square missing from occupied
+	Bitboard attackersTo(int sq, Bitboard occupied) const;
+	Bitboard attackersTo(int sq) const { return attackersTo(sq, occupied); }
+
+	// True if any piece of byColor attacks sq, cheapest pieces are tried first
+	bool isAttacked(int sq, int byColor, Bitboard occupied) const;
+	bool isAttacked(int sq, int byColor) const { return isAttacked(sq, byColor, occupied); }
+	bool inCheck() const;
+
+	// Every square attacked by color, built for the whole side at once
+	Bitboard attacksBy(int color, Bitboard occupied) const;
+	Bitboard attacksBy(int color) const { return attacksBy(color, occupied); }
+
+	// Static exchange evaluation, true if m wins at least threshold once both sides have traded off on its target square
+	// Each side recaptures with its cheapest piece and may stop when going on loses, pins and checks are ignored
+	bool seeGE(Move m, int threshold = 0) const;
+
+	// Draws
+	// Times the current position was seen before, only positions since the last capture or pawn move are looked at
+	int repetitions() const;
+	bool fiftyMoveRule() const { return halfmoveClock >= 100; }
+	bool insufficientMaterial() const;
+	// Draw by rule, the game needs a position seen twice before, search treats a single repeat as a draw
+	bool isDraw(int reps = 2) const { return fiftyMoveRule() || insufficientMaterial() || repetitions() >= reps; }
+
+	// Turns attack tracking on (rebuilding the maps from scratch) or off
+	void trackAttacks(bool on);
+
+	// Zobrist hash of the position (pieces, side to move, castling rights and en passant file) built from scratch
+	uint64_t computeKey() const;
+
+private:
+	bool tracking;
+
+	// Make and unmake for a known side to move
+	template<int Us> void doMove(Move m);
+	template<int Us> void undoMove(const sUndo& undo);
+
+	// Sliders whose rays reach sq, the only pieces whose attacks change when sq fills or empties
+	Bitboard slidersTo(int sq) const;
+	void countAttacks(int color, Bitboard targets, int delta);
+	void countSliders(Bitboard sliders, int delta);
+
+	// Undo stack used as a ring, a long game only loses its oldest entries
+	sUndo history[MAX_HISTORY];
+	int historyCount;
+	int ply;
+};
+
+// Queries used by move generation are kept inline
+
+inline Bitboard cBoard::attackersTo(int sq, Bitboard occupied) const {
+	return (PawnAttacks(BLACK, sq) & piecesOf(WHITE, PAWN))
+		| (PawnAttacks(WHITE, sq) & piecesOf(BLACK, PAWN))
+		| (KnightAttacks(sq) & pieces[KNIGHT])
+		| (KingAttacks(sq) & pieces[KING])
+		| (BishopAttacks(sq, occupied) & (pieces[BISHOP] | pieces[QUEEN]))
+		| (RookAttacks(sq, occupied) & (pieces[ROOK] | pieces[QUEEN]));
+}
+
+// A pawn of byColor attacks sq from the squares a pawn of the other color on sq would attack
+inline bool cBoard::isAttacked(int sq, int byColor, Bitboard occupied) const {
+	Bitboard them = colors[byColor];
+
+	return (PawnAttacks(byColor ^ 1, sq) & pieces[PAWN] & them)
+		|| (KnightAttacks(sq) & pieces[KNIGHT] & them)
+		|| (KingAttacks(sq) & pieces[KING] & them)
+		|| (BishopAttacks(sq, occupied) & (pieces[BISHOP] | pieces[QUEEN]) & them)
+		|| (RookAttacks(sq, occupied) & (pieces[ROOK] | pieces[QUEEN]) & them);
+}
+
+// Side to move's king is attacked
+inline bool cBoard::inCheck() const {
+	int ksq = kingSquare(sideToMove);
+
+	return ksq >= 0 && isAttacked(ksq, sideToMove ^ 1);
+}
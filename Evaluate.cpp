@@ -0,0 +1,101 @@
+#include "Evaluate.h"
+
+// ######################### PIECE-SQUARE TABLES ###################### //
+// Bonus for a piece standing on a square, written as seen by White with rank 8 on the first line
+// White looks a square up as sq ^ 56 (rank flipped), Black uses sq as it is
+
+static const int pawnTable[64] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	 50,  50,  50,  50,  50,  50,  50,  50,
+	 10,  10,  20,  30,  30,  20,  10,  10,
+	  5,   5,  10,  25,  25,  10,   5,   5,
+	  0,   0,   0,  20,  20,   0,   0,   0,
+	  5,  -5, -10,   0,   0, -10,  -5,   5,
+	  5,  10,  10, -20, -20,  10,  10,   5,
+	  0,   0,   0,   0,   0,   0,   0,   0
+};
+
+static const int rookTable[64] = {
+	  0,   0,   0,   0,   0,   0,   0,   0,
+	  5,  10,  10,  10,  10,  10,  10,   5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	 -5,   0,   0,   0,   0,   0,   0,  -5,
+	  0,   0,   0,   5,   5,   0,   0,   0
+};
+
+static const int knightTable[64] = {
+	-50, -40, -30, -30, -30, -30, -40, -50,
+	-40, -20,   0,   0,   0,   0, -20, -40,
+	-30,   0,  10,  15,  15,  10,   0, -30,
+	-30,   5,  15,  20,  20,  15,   5, -30,
+	-30,   0,  15,  20,  20,  15,   0, -30,
+	-30,   5,  10,  15,  15,  10,   5, -30,
+	-40, -20,   0,   5,   5,   0, -20, -40,
+	-50, -40, -30, -30, -30, -30, -40, -50
+};
+
+static const int bishopTable[64] = {
+	-20, -10, -10, -10, -10, -10, -10, -20,
+	-10,   0,   0,   0,   0,   0,   0, -10,
+	-10,   0,   5,  10,  10,   5,   0, -10,
+	-10,   5,   5,  10,  10,   5,   5, -10,
+	-10,   0,  10,  10,  10,  10,   0, -10,
+	-10,  10,  10,  10,  10,  10,  10, -10,
+	-10,   5,   0,   0,   0,   0,   5, -10,
+	-20, -10, -10, -10, -10, -10, -10, -20
+};
+
+static const int queenTable[64] = {
+	-20, -10, -10,  -5,  -5, -10, -10, -20,
+	-10,   0,   0,   0,   0,   0,   0, -10,
+	-10,   0,   5,   5,   5,   5,   0, -10,
+	 -5,   0,   5,   5,   5,   5,   0,  -5,
+	  0,   0,   5,   5,   5,   5,   0,  -5,
+	-10,   5,   5,   5,   5,   5,   0, -10,
+	-10,   0,   5,   0,   0,   0,   0, -10,
+	-20, -10, -10,  -5,  -5, -10, -10, -20
+};
+
+// King stays sheltered behind its pawns
+static const int kingTable[64] = {
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-30, -40, -40, -50, -50, -40, -40, -30,
+	-20, -30, -30, -40, -40, -30, -30, -20,
+	-10, -20, -20, -20, -20, -20, -20, -10,
+	 20,  20,   0,   0,   0,   0,  20,  20,
+	 20,  30,  10,   0,   0,  10,  30,  20
+};
+
+// Indexed by pieceType
+static const int* const pieceTables[6] = { pawnTable, rookTable, knightTable, bishopTable, queenTable, kingTable };
+
+// Centipawns per square a side attacks outside its own pieces
+const int MOBILITY_BONUS = 2;
+
+// ######################### EVALUATE ################################# //
+
+int Evaluate(const cBoard& board) {
+	int score[2] = { 0, 0 };
+
+	for (int color = WHITE; color <= BLACK; color++) {
+		int flip = (color == WHITE) ? 56 : 0;
+
+		for (int type = PAWN; type < KING; type++)
+			score[color] += board.pieceCount[color][type] * PieceValue[type];
+
+		for (int type = PAWN; type <= KING; type++)
+			for (Bitboard b = board.piecesOf(color, type); b; )
+				score[color] += pieceTables[type][PopLsb(b) ^ flip];
+
+		// Whole side attack set in one call
+		score[color] += MOBILITY_BONUS * PopCount(board.attacksBy(color) & ~board.colors[color]);
+	}
+
+	int us = board.sideToMove;
+	return score[us] - score[us ^ 1];
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include "Board.h"
+
+// EVALUATION
+// Static score of a position in centipawns, positive when the side to move is better
+// Material, piece-square tables and a small mobility bonus, nothing that needs a search
+int Evaluate(const cBoard& board);
@@ -27,27 +27,32 @@
 	3. Check for Check/Checkmate
 
 	4. AI (if activated)
+		// Negamax alpha-beta with iterative deepening and a quiescence search at the leaves (cSearch), plays the sides picked with -ai
 
 	5. Send back to Player
 
 	=================== Data Structures ===================
 
-	// Collision is the size of the board (8 x 8)
-		// Used to quickly access if a position is occupied or not 
-	Collision : Int array[64]
+	// Board is stored as bitboards (64-bit sets, one bit per square)
+		// One set per piece type and one per color, used to quickly access if a position is occupied or not
+	Board : cBoard (Bitboard pieces[6], colors[2], occupied)
 	
-	// Check is size of board (8 x 8) // 2 Player to have separate check arrays
-		// Used to quickly access if position is in position of check
-	Check : bool array[64]
+	// Check is an attack count per square for each player, updated by the board as pieces move
+		// Read when drawing to mark a king in check and moves onto squares the opponent attacks
+	Check : cBoard (uint8_t attackCount[2][64], Bitboard attacks[2])
 
 	// Player Pieces of size 16 (16 pieces total) // 2 players so 2 groups of 16 (32 total)
-	Pieces : list<sPieces*> p1(16)
+		// Stored as arrays (type, square, flags) with a square to slot index, King in each player's first slot
+	Pieces : sPieceTable (uint8_t type[32], square[32], flags[32], int8_t slotOn[64])
 */
 
 
 #define OLC_PGE_APPLICATION
 #include "PixelGameEngine.h"
 #include "Pieces.h"
+#include "MoveGen.h"
+#include "Perft.h"
+#include "Search.h"
 
 class Chess : public olc::PixelGameEngine {
 public:
@@ -55,28 +60,41 @@ public:
 		sAppName = "Chess Demo";
 	}
 
+	// Players are a bit per color (1 White, 2 Black) the AI plays for
+	void setAI(int players, const sSearchLimits& limits, size_t hashMB, bool hugePages) {
+		aiPlayers = players;
+		aiLimits = limits;
+
+		aiTable.reset(new cTransTable(hashMB, hugePages));
+		search.setTransTable(aiTable.get());
+	}
+
 private:
 	// Member variables
 	// Board
 	int nWidth = 8;
 	int nHeight = 8;
+	cBoard board;
 	
 	// Player Variables
-	std::list<cPiece*> player1;
-	std::list<cPiece*> player2;
+	// Both player's pieces in one table, looked up by square
+	sPieceTable pieceTable;
 	
-	bool p1CaptureArr[64];
-	bool p2CaptureArr[64];
-
-	// Collision
-	int collisionArr[64] = { 0 };
-
-	// Movement vector
-	std::vector<std::pair<int, int>> moveLoc;
+	// Movement list
+	sMoveList moveLoc;
 	
 	// Player Turn Variables
 	int currentPlayer = 0;
-	cPiece* selectedPiece = nullptr;
+	int selectedSlot = -1;
+
+	// AI
+	std::unique_ptr<cTransTable> aiTable;
+	cSearch search;
+	sSearchLimits aiLimits;
+	int aiPlayers = 0;
+
+	// Shown on the Game Over screen
+	std::string gameOverText;
 
 	// Game Phases
 	enum class gamePhase : short {
@@ -87,90 +105,33 @@ private:
 		GameOver = 0x05
 	} phase;
 
-	enum pieceType {
-		PAWN,
-		ROOK,
-		KNIGHT,
-		BISHOP,
-		QUEEN,
-		KING
-	};
-
-
 	virtual bool OnUserCreate() {
 		// Clear just incase
-		player1.clear();
-		player2.clear();
 		moveLoc.clear();
-		/*
-		// Initialize player pieces
-		for (int i = 0; i < 8; i++) {
-			player1.push_back(new sPiece(PAWN, i, 1));
-			player2.push_back(new sPiece(PAWN, i, 6));
-		}
-		
-		for (int i = 0; i < 2; i++) {
-			player1.push_back(new sPiece(ROOK, i * 7, 0));
-			player2.push_back(new sPiece(ROOK, i * 7, 7));
 
-			player1.push_back(new sPiece(KNIGHT, i * 5 + 1, 0));
-			player2.push_back(new sPiece(KNIGHT, i * 5 + 1, 7));
+		// Initialize Board
+		// Attack maps are kept current by the board from here on
+		board.trackAttacks(true);
+		board.setStartPosition();
 
-			player1.push_back(new sPiece(BISHOP, i * 3 + 2, 0));
-			player2.push_back(new sPiece(BISHOP, i * 3 + 2, 7));
-		}
-		*/
-		// Black pieces bot, White pieces top Queens places on same color tile as the player's pieces
-		// Board tiles go white, black, white, black
-		player2.push_back(new Queen(3, 3, QUEEN));
-		player1.push_back(new King(3, 1, KING));
-
-		// Initialize Collision
-		// Testing Collision
-		collisionArr[27] = 2;
-		collisionArr[11] = 3;
-		//collisionArr[4] = 1;
-		//collisionArr[59] = 2;
-		//collisionArr[60] = 2;
-
-		/* Quick Collision
-		for (int i = 0; i < 8; i++) {			
-			// Player 1 Pieces
-			collisionArr[i] = 1;
-			collisionArr[8 + i] = 1;
-			// Player 2 Pieces
-			collisionArr[48 + i] = 2;
-			collisionArr[56 + i] = 2;
-		}
-		*/
-
-		// Initialize Capture
-		for (int i = 0; i < 64; i++) {
-			p1CaptureArr[i] = false;
-			p2CaptureArr[i] = false;
-		}
-
-		updateCaptureZone(player1, p1CaptureArr);
-		//updateCaptureZone(player2, p2CaptureArr);
+		// Initialize player pieces from the board
+		pieceTable.build(board);
 
 		phase = gamePhase::PlayerPhase;
 
 		return true;
 	}
 
-	// Function to update capture
-	void updateCaptureZone(std::list<cPiece*> player, bool *updateArr) {
-		// Enemy and Ally
-		int enemy = currentPlayer == 0 ? 2 : 1;
-		int ally = currentPlayer + 1;
-
-		// Clear update Arr
-		for (int i = 0; i < 64; i++)
-			updateArr[i] = false;
+	// Draw every piece straight from the piece table
+	void DrawPieces() {
+		for (int color = WHITE; color <= BLACK; color++) {
+			// Player 1 Pieces are blue, Player 2 Pieces are red
+			olc::Pixel col = (color == WHITE) ? olc::BLUE : olc::RED;
 
-		for (auto& p : player) {
-			p->updateZones(currentPlayer, collisionArr, updateArr);
-			
+			for (int slot = pieceTable.first(color); slot < pieceTable.end(color); slot++) {
+				int sq = pieceTable.square[slot];
+				FillRect((sq % nWidth) * 16 + 4, (sq / nWidth) * 16 + 4, 8, 8, col);
+			}
 		}
 	}
 
@@ -192,11 +153,38 @@ private:
 
 		case (gamePhase::PlayerPhase): {
 
+			// AI plays its own turns
+			if (aiPlayers & (1 << currentPlayer)) {
+				sSearchResult result = search.think(board, aiLimits);
+
+				if (result.best != NO_MOVE) {
+					pieceTable.makeMove(result.best);
+					board.makeMove(result.best);
+				}
+
+				phase = gamePhase::UpdatePhase;
+			}
+
 			// Inputs
 			// Is window in focus
-			if (IsFocused()) {
+			else if (IsFocused()) {
+				// Backspace takes back the last move
+				if (GetKey(olc::Key::BACK).bPressed && board.canUnmake()) {
+					board.unmakeMove();
+
+					// AI's reply is taken back with it
+					if ((aiPlayers & (1 << board.sideToMove)) && board.canUnmake())
+						board.unmakeMove();
+
+					pieceTable.build(board);
+
+					currentPlayer = board.sideToMove;
+					selectedSlot = -1;
+					moveLoc.clear();
+				}
+
 				// Left click
-				if (GetMouse(0).bPressed) {
+				else if (GetMouse(0).bPressed) {
 
 					// Mouse position
 					// divided by 16 (bit shift 4) to find proper location in data structure space
@@ -206,11 +194,11 @@ private:
 					// =================== Logic ===============================
 
 					// Is piece selected
-					if (selectedPiece != nullptr) {
+					if (selectedSlot >= 0) {
 						// Check if same unit
-						if (posX == selectedPiece->x && posY == selectedPiece->y) {
+						if (posY * nWidth + posX == pieceTable.square[selectedSlot]) {
 							// Deselect unit
-							selectedPiece = nullptr;
+							selectedSlot = -1;
 
 							// Clear previous valid unit movement locations
 							moveLoc.clear();
@@ -220,38 +208,18 @@ private:
 						else {
 
 							// Check if move is in valid movements
-							for (auto change : moveLoc) {
-
-								// Movement is valid
-								if (change.first == posX && change.second == posY) {
-
-									// Collision with enemy
-									if (collisionArr[posY * nWidth + posX] == (currentPlayer == 0 ? 2 : 1)) {
-										// Find Enemy piece and get rid of it
-										auto it = (currentPlayer == 1) ? player1.begin() : player2.begin();
-										for (auto& p : (currentPlayer == 1) ? player1 : player2) {
-											if (p->x == posX && p->y == posY) {
-												(currentPlayer == 1) ? player1.erase(it) : player2.erase(it);
-												break;
-											}
-											it++;
-										}
-									}
-
-									// Update collisions
-									collisionArr[selectedPiece->y * nWidth + selectedPiece->x] = 0;
-									if (selectedPiece->type == KING)
-										collisionArr[posY * nWidth + posX] = currentPlayer + 3;
-									else
-										collisionArr[posY * nWidth + posX] = currentPlayer + 1;
-
-									// Update Unit position
-									selectedPiece->x = posX;
-									selectedPiece->y = posY;
+							for (Move change : moveLoc) {
+
+								// Movement is valid (pawns reaching the end are promoted to Queen)
+								if (MoveTo(change) == posY * nWidth + posX && (!IsPromotion(change) || PromotionType(change) == QUEEN)) {
 
+									// Update pieces and board
+									// Captured, castled and promoted pieces are handled by the table itself
+									pieceTable.makeMove(change);
+									board.makeMove(change);
 
 									// Clear selection
-									//selectedPiece = nullptr;
+									selectedSlot = -1;
 
 									// clear movement tiles
 									moveLoc.clear();
@@ -266,17 +234,23 @@ private:
 
 					// No Piece selected
 					else {
-						// Find if piece exist in click location
-						for (auto& p : (currentPlayer == 1 ? player2 : player1)) {
-							// Piece found
-							if (p->x == posX && p->y == posY) {
-								// select piece
-								selectedPiece = p;
-
-								// Find valid Movement zones
-								moveLoc = p->movement(currentPlayer, collisionArr, currentPlayer == 0 ? p2CaptureArr : p1CaptureArr);
-								break;
-							}
+						// Only an ally piece can be selected, read straight from the mailbox
+						int sq = posY * nWidth + posX;
+
+						if (board.isAlly(sq, currentPlayer)) {
+							// select piece
+							selectedSlot = pieceTable.slotOn[sq];
+
+							// Find valid Movement zones
+							// Piece's own moves, with king steps onto attacked squares dropped straight from the attack map
+							// Only the legal ones are kept
+							sMoveList pieceMoves;
+							pieceTable.piece(selectedSlot).movement(currentPlayer, board, board.attacks[currentPlayer ^ 1], pieceMoves);
+
+							moveLoc.clear();
+							for (Move m : pieceMoves)
+								if (IsLegal(board, m))
+									moveLoc.add(m);
 						}
 					}
 				}
@@ -286,60 +260,25 @@ private:
 
 		case (gamePhase::UpdatePhase): {
 			
-			// Update Capture Zone
-			updateCaptureZone(player1, p1CaptureArr);
-			updateCaptureZone(player2, p2CaptureArr);
-
-			cPiece* checkKing = (currentPlayer == 0) ? player2.front() : player1.front();
-			bool* checkCap = (currentPlayer == 0) ? p1CaptureArr : p2CaptureArr;
-				
-			// Check for check/checkmate
-			// if King is in check
-			if (checkCap[checkKing->y * nWidth + checkKing->x] == currentPlayer + 1) {
-				// Find all of King's moves available
-				std::vector<std::pair<int, int>> kingMoves = checkKing->movement(currentPlayer, collisionArr, checkCap);
-
-				// If no more moves
-				if (kingMoves.empty()) {
-					// Find if another piece can block
-				
-				}
-					
-
+			// Player to move without a legal move has lost if in check, otherwise it is a stalemate
+			if (!HasLegalMove(board)) {
+				gameOverText = board.inCheck() ? "CHECKMATE!" : "STALEMATE!";
+				phase = gamePhase::GameOver;
+			}
 
-				// If King has moves, Next Turn
-				else {
-					currentPlayer = (currentPlayer == 0) ? 1 : 0;
-					phase = gamePhase::PlayerPhase;
-				}
+			// Threefold repetition, fifty moves without a capture or pawn move, or no mating material left
+			else if (board.isDraw()) {
+				gameOverText = "DRAW!";
+				phase = gamePhase::GameOver;
 			}
 
+			// Next Player's turn
 			else {
-				// Check for Stalemate
-				if (checkKing->type == (currentPlayer == 0) ? player1.back()->type : player2.back()->type) {
-					// Find all of King's moves available
-					std::vector<std::pair<int, int>> kingMoves = checkKing->movement(currentPlayer, collisionArr, checkCap);
-
-					// If no more moves, Stalemate
-					if (kingMoves.empty())
-						phase = gamePhase::GameOver;
-					
-					
-					// If King has moves, Next Turn
-					else {
-						currentPlayer = (currentPlayer == 0) ? 1 : 0;
-						phase = gamePhase::PlayerPhase;
-					}
-				}
-
-				// Next Player's turn
-				else {
-					currentPlayer = (currentPlayer == 0) ? 1 : 0;
-					phase = gamePhase::PlayerPhase;
-				}
+				currentPlayer = (currentPlayer == 0) ? 1 : 0;
+				phase = gamePhase::PlayerPhase;
 			}
 
-			selectedPiece = nullptr;
+			selectedSlot = -1;
 		}
 		break;
 
@@ -361,22 +300,23 @@ private:
 				}
 			}
 
-			// Draw Valid Spaces
-			for (auto& sp : moveLoc)
-				FillRect((sp.first << 4) + 1, (sp.second << 4) + 1, 14, 14, olc::GREEN);
-
-			if (selectedPiece != nullptr)
-				FillRect((selectedPiece->x << 4) + 1, (selectedPiece->y << 4) + 1, 14, 14, olc::YELLOW);
+			// King of the player to move is marked while it is attacked
+			int kingSq = board.kingSquare(currentPlayer);
+			if (kingSq >= 0 && (board.attacks[currentPlayer ^ 1] & SquareBB(kingSq)))
+				FillRect((kingSq % nWidth << 4) + 1, (kingSq / nWidth << 4) + 1, 14, 14, olc::RED);
 
-			// Draw Player 1 Pieces
-			for (auto& piece : player1) {
-				FillRect(piece->x * 16 + 4, piece->y * 16 + 4, 8, 8, olc::BLUE);
+			// Draw Valid Spaces
+			// Squares the opponent attacks are shaded darker
+			for (Move sp : moveLoc) {
+				bool attacked = board.attacks[currentPlayer ^ 1] & SquareBB(MoveTo(sp));
+				FillRect((MoveTo(sp) % nWidth << 4) + 1, (MoveTo(sp) / nWidth << 4) + 1, 14, 14, attacked ? olc::DARK_GREEN : olc::GREEN);
 			}
 
-			// Player 2 Pieces
-			for (auto& piece : player2) {
-				FillRect(piece->x * 16 + 4, piece->y * 16 + 4, 8, 8, olc::RED);
-			}
+			if (selectedSlot >= 0)
+				FillRect(((pieceTable.square[selectedSlot] % nWidth) << 4) + 1, ((pieceTable.square[selectedSlot] / nWidth) << 4) + 1, 14, 14, olc::YELLOW);
+
+			// Draw Pieces
+			DrawPieces();
 
 		}
 
@@ -393,13 +333,7 @@ private:
 			}
 
 			// Draw Pieces
-			for (auto& piece : player1) {
-				FillRect(piece->x * 16 + 4, piece->y * 16 + 4, 8, 8, olc::BLUE);
-			}
-
-			for (auto& piece : player2) {
-				FillRect(piece->x * 16 + 4, piece->y * 16 + 4, 8, 8, olc::RED);
-			}
+			DrawPieces();
 
 		}
 	
@@ -424,7 +358,7 @@ private:
 			FillRect(23, 50, 83, 12, olc::Pixel(100, 100, 200));
 
 			// Draw String
-			DrawString(25, 52, "CHECKMATE!", olc::WHITE, 1);
+			DrawString(25, 52, gameOverText, olc::WHITE, 1);
 		}
 
 		break;
@@ -437,10 +371,121 @@ private:
 
 };
 
-int main() {
+// Command line tools, every command but play runs without opening the game window
+//	play					Game window, the default when no command is given
+//	perft <depth> [fen]		Leaf count of the move tree, run on every core
+//	divide <depth> [fen]	Leaf count per root move
+//	perft suite				Standard perft positions checked against their published counts
+//	search <depth> [fen]	Best move of the position, printed with every finished iteration
+// Options
+//	-t <threads>			Threads used by perft and the search (default every hardware thread)
+//	-s <ply>				Ply perft splits the tree into parallel subtrees at (default 2)
+//	-h <MB>					Perft cache size, 0 turns the cache off (default 0)
+//							Also the transposition table size of search and play (default 16)
+//	-huge					Back the transposition table with huge pages where the system allows it
+//	-d <depth>				Deepest iteration the AI searches in play
+//	-m <ms>					Time limit per move of play and search (play defaults to 1000 when no depth is given)
+//	-ai white|black|both	Sides the AI plays in play
+int runCommand(int argc, char* argv[]) {
+	// Pull options out, whatever is left is the command and its arguments
+	std::vector<std::string> args;
+	int threads = 0;
+	int splitPly = 2;
+	int hashMB = 0;
+	int aiPlayers = 0;
+	bool hugePages = false;
+	sSearchLimits limits;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+
+		if (arg == "-t" && i + 1 < argc)
+			threads = atoi(argv[++i]);
+		else if (arg == "-s" && i + 1 < argc)
+			splitPly = atoi(argv[++i]);
+		else if (arg == "-h" && i + 1 < argc)
+			hashMB = atoi(argv[++i]);
+		else if (arg == "-d" && i + 1 < argc)
+			limits.depth = atoi(argv[++i]);
+		else if (arg == "-m" && i + 1 < argc)
+			limits.timeMs = atoi(argv[++i]);
+		else if (arg == "-huge")
+			hugePages = true;
+		else if (arg == "-ai" && i + 1 < argc) {
+			std::string side = argv[++i];
+			aiPlayers = (side == "white") ? 1 : (side == "black") ? 2 : (side == "both") ? 3 : 0;
+		}
+		else
+			args.push_back(arg);
+	}
+
+	if (args.size() > 1 && args[0] == "perft" && args[1] == "suite")
+		return PerftSuite(threads, splitPly, hashMB) ? 0 : 1;
+
+	// Search threads, 0 uses every hardware thread like perft does
+	limits.threads = (threads > 0) ? threads : (int)std::thread::hardware_concurrency();
+
+	// Game window, with the AI playing the chosen side at the given depth or time
+	if (args.empty() || args[0] == "play") {
+		if (limits.depth == MAX_PLY && limits.timeMs == 0)
+			limits.timeMs = 1000;
+
+		Chess game;
+		game.setAI(aiPlayers, limits, hashMB > 0 ? hashMB : 16, hugePages);
+		if (game.Construct(128, 128, 4, 4))
+			game.Start();
+
+		return 0;
+	}
+
+	if (args.size() > 1 && (args[0] == "perft" || args[0] == "divide" || args[0] == "search")) {
+		int depth = atoi(args[1].c_str());
+
+		// Rest of the arguments make up the FEN
+		std::string fen;
+		for (size_t i = 2; i < args.size(); i++)
+			fen += args[i] + " ";
+
+		cBoard board;
+		if (fen.empty())
+			board.setStartPosition();
+		else if (!board.setFen(fen)) {
+			std::cout << "Invalid FEN: " << fen << std::endl;
+			return 1;
+		}
+
+		if (args[0] == "perft")
+			RunPerft(board, depth, threads, splitPly, hashMB);
+		else if (args[0] == "divide")
+			Divide(board, depth);
+		else {
+			limits.depth = depth;
+
+			cTransTable tt(hashMB > 0 ? hashMB : 16, hugePages);
+			cSearch search(&tt);
+			sSearchResult result = search.think(board, limits);
+			// Checkmate or stalemate leaves nothing to play
+			std::cout << "Best: " << (result.best != NO_MOVE ? MoveToString(result.best) : "(none)") << std::endl;
+		}
+
+		return 0;
+	}
+
+	std::cout << "Usage: " << argv[0] << " [-t threads] [-s ply] [-h MB] [-d depth] [-m ms] [-ai white|black|both] [-huge]"
+		<< " [play | perft <depth> [fen] | divide <depth> [fen] | perft suite | search <depth> [fen]]" << std::endl;
+	return 1;
+}
+
+int main(int argc, char* argv[]) {
+	// Build attack tables before anything reads the board
+	InitBitboards();
+
+	if (argc > 1)
+		return runCommand(argc, argv);
+
 	Chess game;
 	if (game.Construct(128, 128, 4, 4))
 		game.Start();
 	
 	return 0;
-}
\ No newline at end of file
+}
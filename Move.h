@@ -0,0 +1,109 @@
+#pragma once
+
+#include <string>
+#include "Bitboard.h"
+
+// MOVE
+// Packed into 16 bits
+//	bits 0 - 5   : from square
+//	bits 6 - 11  : to square
+//	bits 12 - 15 : flags
+typedef uint16_t Move;
+
+const Move NO_MOVE = 0;
+
+// Move flags
+// Bit 2 (value 4) marks a capture, bit 3 (value 8) marks a promotion
+// Promotion piece is in the low 2 bits (Knight, Bishop, Rook, Queen)
+enum moveFlag {
+	QUIET = 0x0,
+	DOUBLE_PUSH = 0x1,
+	CASTLE_KING = 0x2,
+	CASTLE_QUEEN = 0x3,
+	CAPTURE = 0x4,
+	EN_PASSANT = 0x5,
+	PROMOTION = 0x8,
+	PROMO_CAPTURE = 0xC
+};
+
+inline Move MakeMove(int from, int to, int flags = QUIET) {
+	return (Move)(from | (to << 6) | (flags << 12));
+}
+
+inline int MoveFrom(Move m) {
+	return m & 0x3F;
+}
+
+inline int MoveTo(Move m) {
+	return (m >> 6) & 0x3F;
+}
+
+inline int MoveFlags(Move m) {
+	return m >> 12;
+}
+
+inline bool IsCapture(Move m) {
+	return (m >> 12) & CAPTURE;
+}
+
+inline bool IsPromotion(Move m) {
+	return (m >> 12) & PROMOTION;
+}
+
+inline int PromotionType(Move m) {
+	const int promoTypes[4] = { KNIGHT, BISHOP, ROOK, QUEEN };
+	return promoTypes[(m >> 12) & 0x3];
+}
+
+// Coordinate notation (e2e4, e7e8q), files a - h are x = 0 - 7 and ranks 1 - 8 are y = 0 - 7
+inline std::string MoveToString(Move m) {
+	std::string str;
+	str += (char)('a' + (MoveFrom(m) & 7));
+	str += (char)('1' + (MoveFrom(m) >> 3));
+	str += (char)('a' + (MoveTo(m) & 7));
+	str += (char)('1' + (MoveTo(m) >> 3));
+
+	if (IsPromotion(m))
+		str += "nbrq"[(m >> 12) & 0x3];
+
+	return str;
+}
+
+// MOVE LIST
+// Fixed capacity list kept on the stack, no position has more than 218 legal moves
+const int MAX_MOVES = 256;
+
+struct sMoveList {
+	Move moves[MAX_MOVES];
+	int count = 0;
+
+	void add(Move m) { moves[count++] = m; }
+	void clear() { count = 0; }
+	int size() const { return count; }
+	bool empty() const { return count == 0; }
+
+	Move* begin() { return moves; }
+	Move* end() { return moves + count; }
+	const Move* begin() const { return moves; }
+	const Move* end() const { return moves + count; }
+};
+
+// Adds a move from one square to every square in targets, flagged as a capture when an enemy is there
+inline void AddMoves(sMoveList& list, int from, Bitboard targets, Bitboard enemy) {
+	while (targets) {
+		int to = PopLsb(targets);
+		list.add(MakeMove(from, to, (enemy & SquareBB(to)) ? CAPTURE : QUIET));
+	}
+}
+
+// Adds a pawn move, expanded into the 4 promotions when it reaches the last row
+inline void AddPawnMove(sMoveList& list, int from, int to, bool capture) {
+	int flags = capture ? CAPTURE : QUIET;
+
+	if ((to >> 3) == 0 || (to >> 3) == 7) {
+		for (int promo = 3; promo >= 0; promo--)
+			list.add(MakeMove(from, to, flags | PROMOTION | promo));
+	}
+	else
+		list.add(MakeMove(from, to, flags));
+}
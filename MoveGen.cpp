@@ -0,0 +1,373 @@
+#include "MoveGen.h"
+
+// Shifts a whole set one step, positive steps move towards y + 1
+// Step is known at compile time so only one shift is emitted
+template<int Step>
+static inline Bitboard Shift(Bitboard b) {
+	if constexpr (Step > 0)
+		return b << Step;
+	else
+		return b >> -Step;
+}
+
+// Castling squares are free and not attacked, the king must not be in check either
+static bool castlePathClear(const cBoard& board, int us, bool kingSide) {
+	int rank = (us == WHITE) ? 0 : 56;
+	int them = us ^ 1;
+
+	if (kingSide)
+		return (board.castleRights & ((us == WHITE) ? WHITE_OO : BLACK_OO))
+			&& !(board.occupied & (SquareBB(rank + 5) | SquareBB(rank + 6)))
+			&& !board.isAttacked(rank + 5, them) && !board.isAttacked(rank + 6, them);
+
+	return (board.castleRights & ((us == WHITE) ? WHITE_OOO : BLACK_OOO))
+		&& !(board.occupied & (SquareBB(rank + 1) | SquareBB(rank + 2) | SquareBB(rank + 3)))
+		&& !board.isAttacked(rank + 2, them) && !board.isAttacked(rank + 3, them);
+}
+
+// Checks and pins of the side to move, shared by every legality path so they cannot drift apart
+struct sCheckInfo {
+	Bitboard enemyDiag;		// Enemy bishops and queens
+	Bitboard enemyLine;		// Enemy rooks and queens
+	Bitboard checkers;		// Enemy pieces giving check
+	Bitboard checkMask;		// Squares that resolve a single check, every square when not in check
+	Bitboard pinned;		// Allies alone between the king and an enemy slider
+};
+
+template<int Us>
+static sCheckInfo checkInfo(const cBoard& board, int ksq) {
+	constexpr int Them = Us ^ 1;
+	sCheckInfo info;
+
+	info.enemyDiag = board.piecesOf(Them, BISHOP) | board.piecesOf(Them, QUEEN);
+	info.enemyLine = board.piecesOf(Them, ROOK) | board.piecesOf(Them, QUEEN);
+	info.checkers = board.attackersTo(ksq) & board.colors[Them];
+
+	// Capture the checker or block its ray
+	info.checkMask = info.checkers ? info.checkers | BetweenBB(ksq, Lsb(info.checkers)) : ~0ULL;
+
+	// Pinned pieces can only move along the line to their king
+	info.pinned = 0;
+	Bitboard snipers = (RookAttacks(ksq, 0) & info.enemyLine) | (BishopAttacks(ksq, 0) & info.enemyDiag);
+	while (snipers) {
+		Bitboard blockers = BetweenBB(ksq, PopLsb(snipers)) & board.occupied;
+
+		if (blockers && !MoreThanOne(blockers) && (blockers & board.colors[Us]))
+			info.pinned |= blockers;
+	}
+
+	return info;
+}
+
+// Side to move and the kind of moves wanted are template parameters, every constant below is folded by the compiler
+// Captures are every capture, en passant and every promotion, quiets are everything else
+template<int Us, genType Type>
+static void generate(const cBoard& board, sMoveList& list) {
+	constexpr int Them = Us ^ 1;
+	constexpr int up = (Us == WHITE) ? 8 : -8;
+	constexpr int upLeft = up - 1;
+	constexpr int upRight = up + 1;
+	constexpr Bitboard doubleRank = (Us == WHITE) ? (RANK_2 << 8) : (RANK_7 >> 8);
+	constexpr Bitboard lastRank = (Us == WHITE) ? RANK_8 : RANK_1;
+
+	int ksq = board.kingSquare(Us);
+
+	Bitboard ally = board.colors[Us];
+	Bitboard enemy = board.colors[Them];
+	Bitboard occupied = board.occupied;
+	Bitboard empty = ~occupied;
+
+	// Destination squares for the kind of moves wanted
+	Bitboard wanted = (Type == GEN_CAPTURES) ? enemy : (Type == GEN_QUIETS) ? empty : ~ally;
+
+	// No king, no legal moves
+	if (ksq < 0)
+		return;
+
+	// ######################### KING ################################# //
+	// King is taken off the board so it cannot step backwards along a checking ray
+	Bitboard kingless = occupied ^ SquareBB(ksq);
+	for (Bitboard b = KingAttacks(ksq) & wanted; b; ) {
+		int to = PopLsb(b);
+
+		if (!board.isAttacked(to, Them, kingless))
+			list.add(MakeMove(ksq, to, (enemy & SquareBB(to)) ? CAPTURE : QUIET));
+	}
+
+	sCheckInfo info = checkInfo<Us>(board, ksq);
+	Bitboard checkers = info.checkers;
+	Bitboard checkMask = info.checkMask;
+	Bitboard pinned = info.pinned;
+
+	// Double check, only the king can move
+	if (MoreThanOne(checkers))
+		return;
+
+	// ######################### PAWNS ################################ //
+	// Pushes and captures are done for every pawn at once
+	Bitboard pawns = board.piecesOf(Us, PAWN);
+
+	// Pawns pinned on the king's file can still push, other pinned pawns cannot
+	Bitboard pushers = pawns & (~pinned | (FILE_A << (ksq & 7)));
+
+	Bitboard push = Shift<up>(pushers) & empty;
+	Bitboard doublePush = Shift<up>(push & doubleRank) & empty & checkMask;
+	push &= checkMask;
+
+	if (Type != GEN_CAPTURES) {
+		for (Bitboard b = push & ~lastRank; b; ) {
+			int to = PopLsb(b);
+			list.add(MakeMove(to - up, to));
+		}
+
+		while (doublePush) {
+			int to = PopLsb(doublePush);
+			list.add(MakeMove(to - up - up, to, DOUBLE_PUSH));
+		}
+	}
+
+	// Promotions and en passant are generated with the captures
+	if (Type != GEN_QUIETS) {
+		for (Bitboard b = push & lastRank; b; ) {
+			int to = PopLsb(b);
+			AddPawnMove(list, to - up, to, false);
+		}
+
+		// Unpinned pawns capture both ways, a step off the side would wrap so that file is left out
+		Bitboard targets = enemy & checkMask;
+
+		Bitboard captureLeft = Shift<upLeft>(pawns & ~pinned & ~FILE_A) & targets;
+		Bitboard captureRight = Shift<upRight>(pawns & ~pinned & ~FILE_H) & targets;
+
+		while (captureLeft) {
+			int to = PopLsb(captureLeft);
+			AddPawnMove(list, to - upLeft, to, true);
+		}
+
+		while (captureRight) {
+			int to = PopLsb(captureRight);
+			AddPawnMove(list, to - upRight, to, true);
+		}
+
+		// Pinned pawns can only take the pinning piece
+		for (Bitboard b = pawns & pinned; b; ) {
+			int from = PopLsb(b);
+			Bitboard captures = PawnAttacks(Us, from) & targets & LineBB(ksq, from);
+
+			while (captures)
+				AddPawnMove(list, from, PopLsb(captures), true);
+		}
+
+		// En passant removes two pieces from the same row, so it is tested on the board it leaves behind
+		if (board.epSquare >= 0) {
+			int capSq = board.epSquare - up;
+			Bitboard candidates = PawnAttacks(Them, board.epSquare) & pawns;
+
+			// Leaper checks are only resolved by taking the checking pawn
+			bool unresolved = (checkers & ~SquareBB(capSq) & (board.piecesOf(Them, PAWN) | board.piecesOf(Them, KNIGHT))) != 0;
+
+			while (candidates && !unresolved) {
+				int from = PopLsb(candidates);
+				Bitboard after = (occupied ^ SquareBB(from) ^ SquareBB(capSq)) | SquareBB(board.epSquare);
+
+				if (!(RookAttacks(ksq, after) & info.enemyLine) && !(BishopAttacks(ksq, after) & info.enemyDiag))
+					list.add(MakeMove(from, board.epSquare, EN_PASSANT));
+			}
+		}
+	}
+
+	// ######################### PIECES ############################### //
+	Bitboard targets = wanted & checkMask;
+
+	// Pinned knights can never stay on the line
+	for (Bitboard b = board.piecesOf(Us, KNIGHT) & ~pinned; b; ) {
+		int from = PopLsb(b);
+		AddMoves(list, from, KnightAttacks(from) & targets, enemy);
+	}
+
+	for (Bitboard b = board.piecesOf(Us, BISHOP); b; ) {
+		int from = PopLsb(b);
+		Bitboard pinLine = (pinned & SquareBB(from)) ? LineBB(ksq, from) : ~0ULL;
+		AddMoves(list, from, BishopAttacks(from, occupied) & targets & pinLine, enemy);
+	}
+
+	for (Bitboard b = board.piecesOf(Us, ROOK); b; ) {
+		int from = PopLsb(b);
+		Bitboard pinLine = (pinned & SquareBB(from)) ? LineBB(ksq, from) : ~0ULL;
+		AddMoves(list, from, RookAttacks(from, occupied) & targets & pinLine, enemy);
+	}
+
+	for (Bitboard b = board.piecesOf(Us, QUEEN); b; ) {
+		int from = PopLsb(b);
+		Bitboard pinLine = (pinned & SquareBB(from)) ? LineBB(ksq, from) : ~0ULL;
+		AddMoves(list, from, QueenAttacks(from, occupied) & targets & pinLine, enemy);
+	}
+
+	// ######################### CASTLING ############################# //
+	// King may not castle out of, through or into check
+	if (Type != GEN_CAPTURES && !checkers) {
+		if (castlePathClear(board, Us, true))
+			list.add(MakeMove(ksq, ksq + 2, CASTLE_KING));
+
+		if (castlePathClear(board, Us, false))
+			list.add(MakeMove(ksq, ksq - 2, CASTLE_QUEEN));
+	}
+}
+
+void GenerateMoves(const cBoard& board, sMoveList& list, genType type) {
+	if (board.sideToMove == WHITE) {
+		switch (type) {
+		case GEN_ALL:		generate<WHITE, GEN_ALL>(board, list); break;
+		case GEN_CAPTURES:	generate<WHITE, GEN_CAPTURES>(board, list); break;
+		case GEN_QUIETS:	generate<WHITE, GEN_QUIETS>(board, list); break;
+		}
+	}
+	else {
+		switch (type) {
+		case GEN_ALL:		generate<BLACK, GEN_ALL>(board, list); break;
+		case GEN_CAPTURES:	generate<BLACK, GEN_CAPTURES>(board, list); break;
+		case GEN_QUIETS:	generate<BLACK, GEN_QUIETS>(board, list); break;
+		}
+	}
+}
+
+// Same checks as generate, but stops at the first legal move found
+// Castling is never needed, a legal castle means the king's step towards the rook is legal too
+template<int Us>
+static bool hasLegalMove(const cBoard& board) {
+	constexpr int Them = Us ^ 1;
+	constexpr int up = (Us == WHITE) ? 8 : -8;
+	constexpr int upLeft = up - 1;
+	constexpr int upRight = up + 1;
+
+	int ksq = board.kingSquare(Us);
+	if (ksq < 0)
+		return false;
+
+	Bitboard ally = board.colors[Us];
+	Bitboard enemy = board.colors[Them];
+	Bitboard occupied = board.occupied;
+
+	// King steps first, they settle most positions and are all a double check allows
+	Bitboard kingless = occupied ^ SquareBB(ksq);
+	for (Bitboard b = KingAttacks(ksq) & ~ally; b; )
+		if (!board.isAttacked(PopLsb(b), Them, kingless))
+			return true;
+
+	sCheckInfo info = checkInfo<Us>(board, ksq);
+	if (MoreThanOne(info.checkers))
+		return false;
+
+	Bitboard checkMask = info.checkMask;
+	Bitboard pinned = info.pinned;
+
+	Bitboard targets = ~ally & checkMask;
+
+	// Pieces, without any pin a single target is enough
+	for (Bitboard b = board.piecesOf(Us, KNIGHT) & ~pinned; b; )
+		if (KnightAttacks(PopLsb(b)) & targets)
+			return true;
+
+	for (Bitboard b = (board.pieces[BISHOP] | board.pieces[ROOK] | board.pieces[QUEEN]) & ally; b; ) {
+		int from = PopLsb(b);
+		Bitboard pinLine = (pinned & SquareBB(from)) ? LineBB(ksq, from) : ~0ULL;
+
+		if (AttacksFrom(board.typeOn(from), Us, from, occupied) & targets & pinLine)
+			return true;
+	}
+
+	// Pawns
+	Bitboard pawns = board.piecesOf(Us, PAWN);
+	Bitboard pushers = pawns & (~pinned | (FILE_A << (ksq & 7)));
+	Bitboard push = Shift<up>(pushers) & ~occupied;
+	constexpr Bitboard doubleRank = (Us == WHITE) ? (RANK_2 << 8) : (RANK_7 >> 8);
+
+	if ((push | Shift<up>(push & doubleRank)) & ~occupied & checkMask)
+		return true;
+
+	Bitboard captures = enemy & checkMask;
+	if ((Shift<upLeft>(pawns & ~pinned & ~FILE_A) | Shift<upRight>(pawns & ~pinned & ~FILE_H)) & captures)
+		return true;
+
+	for (Bitboard b = pawns & pinned; b; ) {
+		int from = PopLsb(b);
+		if (PawnAttacks(Us, from) & captures & LineBB(ksq, from))
+			return true;
+	}
+
+	// En passant is rare enough to go through the full legality test
+	if (board.epSquare >= 0) {
+		for (Bitboard b = PawnAttacks(Them, board.epSquare) & pawns; b; )
+			if (IsLegal(board, MakeMove(PopLsb(b), board.epSquare, EN_PASSANT)))
+				return true;
+	}
+
+	return false;
+}
+
+bool HasLegalMove(const cBoard& board) {
+	return (board.sideToMove == WHITE) ? hasLegalMove<WHITE>(board) : hasLegalMove<BLACK>(board);
+}
+
+// Checks a move from anywhere (hash table, killer slots) against the position without generating every move
+bool IsLegal(const cBoard& board, Move m) {
+	int us = board.sideToMove;
+	int from = MoveFrom(m);
+	int to = MoveTo(m);
+	int flags = MoveFlags(m);
+	int up = (us == WHITE) ? 8 : -8;
+
+	if (m == NO_MOVE || !board.isAlly(from, us) || board.isAlly(to, us))
+		return false;
+
+	int type = board.typeOn(from);
+	int ksq = (type == KING) ? to : board.kingSquare(us);
+	int capSq = to;
+
+	if (ksq < 0)
+		return false;
+
+	// Move has to be one the piece can make from here, with flags matching the board
+	switch (flags) {
+	case EN_PASSANT:
+		if (type != PAWN || to != board.epSquare || !(PawnAttacks(us, from) & SquareBB(to)))
+			return false;
+		capSq = to - up;
+		break;
+
+	case CASTLE_KING:
+	case CASTLE_QUEEN:
+		return type == KING && from == ((us == WHITE) ? 4 : 60)
+			&& to == from + ((flags == CASTLE_KING) ? 2 : -2)
+			&& !board.inCheck() && castlePathClear(board, us, flags == CASTLE_KING);
+
+	case DOUBLE_PUSH:
+		if (type != PAWN || to != from + up + up || (from >> 3) != ((us == WHITE) ? 1 : 6)
+			|| (board.occupied & (SquareBB(from + up) | SquareBB(to))))
+			return false;
+		break;
+
+	default: {
+		bool capture = board.isEnemy(to, us);
+		bool lastRow = (to >> 3) == 0 || (to >> 3) == 7;
+
+		// Only quiet, capture and promotion flags are left
+		if (capture != IsCapture(m) || (!IsPromotion(m) && flags != QUIET && flags != CAPTURE))
+			return false;
+
+		if (type == PAWN) {
+			if (IsPromotion(m) != lastRow)
+				return false;
+			if (capture ? !(PawnAttacks(us, from) & SquareBB(to)) : to != from + up)
+				return false;
+		}
+		else if (IsPromotion(m) || !(AttacksFrom(type, us, from, board.occupied) & SquareBB(to)))
+			return false;
+	}
+	}
+
+	// King may not be left attacked, the captured piece no longer attacks anything
+	Bitboard after = (board.occupied ^ SquareBB(from) ^ SquareBB(capSq)) | SquareBB(to);
+
+	return !(board.attackersTo(ksq, after) & board.colors[us ^ 1] & ~SquareBB(capSq));
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Board.h"
+
+// Kinds of moves to generate
+// Captures also hold en passant and every promotion, quiets hold everything else (castling included)
+enum genType {
+	GEN_ALL,
+	GEN_CAPTURES,
+	GEN_QUIETS
+};
+
+// Fills list with every legal move of the side to move in one call
+// Checkers, pins and evasion squares are worked out once up front, so no move needs testing afterwards
+void GenerateMoves(const cBoard& board, sMoveList& list, genType type = GEN_ALL);
+
+// True if the side to move has any legal move, stops at the first one found
+// With inCheck() this tells checkmate (in check) from stalemate (not in check)
+bool HasLegalMove(const cBoard& board);
+
+// True if m is a legal move for the side to move, used for moves that did not come from the generator
+bool IsLegal(const cBoard& board, Move m);
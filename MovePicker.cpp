@@ -0,0 +1,149 @@
+#include <utility>
+#include "MovePicker.h"
+
+cMovePicker::cMovePicker(const cBoard& nboard, Move nhashMove, const Move killers[2], Move counter,
+	const int16_t (*nhistory)[64]) : board(nboard), history(nhistory), withQuiets(true) {
+	curStage = STAGE_HASH;
+	hashMove = IsLegal(board, nhashMove) ? nhashMove : NO_MOVE;
+
+	// Killers and counter move are quiet moves, captures are already tried in their own stage
+	specialCount = 0;
+	specialIndex = 0;
+
+	Move candidates[3] = { killers ? killers[0] : NO_MOVE, killers ? killers[1] : NO_MOVE, counter };
+	for (Move m : candidates) {
+		if (m == NO_MOVE || m == hashMove || IsCapture(m) || IsPromotion(m))
+			continue;
+
+		bool duplicate = false;
+		for (int i = 0; i < specialCount; i++)
+			duplicate |= special[i] == m;
+
+		if (!duplicate)
+			special[specialCount++] = m;
+	}
+
+	index = 0;
+}
+
+cMovePicker::cMovePicker(const cBoard& nboard) : board(nboard), history(nullptr), withQuiets(false) {
+	curStage = STAGE_GEN_CAPTURES;
+	hashMove = NO_MOVE;
+	specialCount = 0;
+	specialIndex = 0;
+	index = 0;
+}
+
+// Cheapest attacker first among captures of the same victim, pawn < knight < bishop < rook < queen < king
+// Ranked rather than valued so the king's value cannot outweigh the victim
+static const int attackerRank[6] = { 0, 3, 1, 2, 4, 5 };
+
+// Most valuable victim first, ties broken by the least valuable attacker
+// Promotions add the value of the new piece
+void cMovePicker::scoreCaptures() {
+	for (int i = 0; i < moves.size(); i++) {
+		Move m = moves.moves[i];
+		int victim = (MoveFlags(m) == EN_PASSANT) ? PAWN : board.typeOn(MoveTo(m));
+		int attacker = board.typeOn(MoveFrom(m));
+
+		scores[i] = (victim >= 0 ? PieceValue[victim] * 16 : 0) - attackerRank[attacker];
+
+		if (IsPromotion(m))
+			scores[i] += PieceValue[PromotionType(m)] * 16;
+	}
+}
+
+// Quiets that caused cutoffs elsewhere in the tree come first
+void cMovePicker::scoreQuiets() {
+	for (int i = 0; i < moves.size(); i++)
+		scores[i] = history[MoveFrom(moves.moves[i])][MoveTo(moves.moves[i])];
+}
+
+bool cMovePicker::alreadyTried(Move m) const {
+	if (m == hashMove)
+		return true;
+
+	for (int i = 0; i < specialCount; i++)
+		if (special[i] == m)
+			return true;
+
+	return false;
+}
+
+Move cMovePicker::pickBest() {
+	int best = index;
+
+	for (int i = index + 1; i < moves.size(); i++)
+		if (scores[i] > scores[best])
+			best = i;
+
+	std::swap(moves.moves[index], moves.moves[best]);
+	std::swap(scores[index], scores[best]);
+
+	return moves.moves[index++];
+}
+
+Move cMovePicker::next() {
+	switch (curStage) {
+	case STAGE_HASH:
+		curStage = STAGE_GEN_CAPTURES;
+		if (hashMove != NO_MOVE)
+			return hashMove;
+
+		// fall through
+	case STAGE_GEN_CAPTURES:
+		moves.clear();
+		GenerateMoves(board, moves, GEN_CAPTURES);
+		scoreCaptures();
+		index = 0;
+		curStage = STAGE_CAPTURES;
+
+		// fall through
+	case STAGE_CAPTURES:
+		while (index < moves.size()) {
+			Move m = pickBest();
+			if (m != hashMove)
+				return m;
+		}
+
+		if (!withQuiets) {
+			curStage = STAGE_DONE;
+			break;
+		}
+		curStage = STAGE_KILLERS;
+
+		// fall through
+	case STAGE_KILLERS:
+		while (specialIndex < specialCount) {
+			Move m = special[specialIndex++];
+			// Killers come from other positions, an illegal one is never generated here either
+			if (IsLegal(board, m))
+				return m;
+		}
+		curStage = STAGE_GEN_QUIETS;
+
+		// fall through
+	case STAGE_GEN_QUIETS:
+		moves.clear();
+		GenerateMoves(board, moves, GEN_QUIETS);
+		if (history)
+			scoreQuiets();
+		index = 0;
+		curStage = STAGE_QUIETS;
+
+		// fall through
+	case STAGE_QUIETS:
+		while (index < moves.size()) {
+			Move m = history ? pickBest() : moves.moves[index++];
+			if (!alreadyTried(m))
+				return m;
+		}
+		curStage = STAGE_DONE;
+
+		// fall through
+	case STAGE_DONE:
+		break;
+	}
+
+	return NO_MOVE;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "MoveGen.h"
+
+// Stages the picker goes through in order
+enum pickStage {
+	STAGE_HASH,
+	STAGE_GEN_CAPTURES,
+	STAGE_CAPTURES,
+	STAGE_KILLERS,
+	STAGE_GEN_QUIETS,
+	STAGE_QUIETS,
+	STAGE_DONE
+};
+
+// MOVE PICKER
+// Hands out the legal moves of a position one at a time, best guesses first
+// Each group is only generated once the ones before it are used up, so a node that cuts off early skips the rest
+//	hash move -> captures (most valuable victim, then least valuable attacker) -> killers and counter move -> quiets (by history)
+class cMovePicker {
+public:
+	// Killers and counter move may be NO_MOVE, any that are not legal here are skipped
+	// History is the [from][to] table of the side to move, quiets come in generation order without one
+	cMovePicker(const cBoard& board, Move hashMove, const Move killers[2] = nullptr, Move counter = NO_MOVE,
+		const int16_t (*history)[64] = nullptr);
+	// Captures and promotions only, for the quiescence search
+	cMovePicker(const cBoard& board);
+
+	// Next move to try, NO_MOVE when every move was handed out
+	Move next();
+
+	int stage() const { return curStage; }
+
+private:
+	const cBoard& board;
+	int curStage;
+
+	Move hashMove;
+	const int16_t (*history)[64];
+	bool withQuiets;
+
+	// Killers and counter move, in the order they are tried
+	Move special[3];
+	int specialCount;
+	int specialIndex;
+
+	// Moves of the current group and their scores
+	sMoveList moves;
+	int scores[MAX_MOVES];
+	int index;
+
+	void scoreCaptures();
+	void scoreQuiets();
+	bool alreadyTried(Move m) const;
+
+	// Highest scoring move left in the group is swapped to the front and returned
+	Move pickBest();
+};
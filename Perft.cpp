@@ -0,0 +1,297 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "Perft.h"
+#include "MoveGen.h"
+
+// ######################### CACHE ################################## //
+
+cPerftCache::cPerftCache(size_t megabytes) {
+	size_t slots = 1;
+	while (slots * 2 * sizeof(sEntry) <= megabytes * 1024 * 1024)
+		slots *= 2;
+
+	entries.reset(new sEntry[slots]);
+	mask = slots - 1;
+
+	for (size_t i = 0; i < slots; i++) {
+		entries[i].check.store(0, std::memory_order_relaxed);
+		entries[i].data.store(0, std::memory_order_relaxed);
+	}
+}
+
+bool cPerftCache::probe(uint64_t key, int depth, uint64_t& nodes) const {
+	const sEntry& e = entries[key & mask];
+	uint64_t data = e.data.load(std::memory_order_relaxed);
+	uint64_t check = e.check.load(std::memory_order_relaxed);
+
+	if ((check ^ data) != key || (int)(data & 0xFF) != depth)
+		return false;
+
+	nodes = data >> 8;
+	return true;
+}
+
+void cPerftCache::store(uint64_t key, int depth, uint64_t nodes) {
+	sEntry& e = entries[key & mask];
+	uint64_t data = (nodes << 8) | (uint64_t)depth;
+
+	e.check.store(key ^ data, std::memory_order_relaxed);
+	e.data.store(data, std::memory_order_relaxed);
+}
+
+// ######################### PERFT ################################## //
+
+uint64_t Perft(cBoard& board, int depth, cPerftCache* cache) {
+	uint64_t nodes = 0;
+
+	// Bulk counted plies are cheaper than a lookup, only cache above them
+	if (cache && depth > 1) {
+		if (cache->probe(board.key, depth, nodes))
+			return nodes;
+	}
+
+	sMoveList moves;
+	GenerateMoves(board, moves);
+
+	// Bulk count, every legal move at the last ply is one leaf
+	if (depth <= 1)
+		return depth == 1 ? moves.size() : 1;
+
+	for (Move m : moves) {
+		board.makeMove(m);
+		nodes += Perft(board, depth - 1, cache);
+		board.unmakeMove();
+	}
+
+	if (cache)
+		cache->store(board.key, depth, nodes);
+
+	return nodes;
+}
+
+// ######################### PARALLEL ############################### //
+
+// Longest move path a task can hold
+const int MAX_SPLIT_PLY = 8;
+
+// Subtree left to count, stored as the moves leading to it from the root
+struct sPerftTask {
+	Move path[MAX_SPLIT_PLY];
+	int length;
+	int depth;
+};
+
+// Each worker owns a queue and a node counter
+// Aligned to a cache line so workers never write to the same line
+struct alignas(64) sPerftWorker {
+	std::mutex lock;
+	std::deque<sPerftTask> tasks;
+	uint64_t nodes = 0;
+};
+
+// Collects every position splitPly plies down as its own task
+static void splitTree(cBoard& board, sPerftTask& task, int splitPly, std::vector<sPerftTask>& tasks) {
+	if (task.length == splitPly || task.depth <= 1) {
+		tasks.push_back(task);
+		return;
+	}
+
+	sMoveList moves;
+	GenerateMoves(board, moves);
+
+	for (Move m : moves) {
+		board.makeMove(m);
+		task.path[task.length++] = m;
+		task.depth--;
+
+		splitTree(board, task, splitPly, tasks);
+
+		task.depth++;
+		task.length--;
+		board.unmakeMove();
+	}
+}
+
+// Takes from the back of its own queue, steals from the front of the others when empty
+// Every task exists before the workers start, so finding all queues empty means the work is done
+static void perftWorker(std::vector<sPerftWorker>& workers, int self, const cBoard& root, cPerftCache* cache) {
+	cBoard board = root;
+	int count = (int)workers.size();
+
+	while (true) {
+		sPerftTask task;
+		bool found = false;
+
+		for (int i = 0; i < count && !found; i++) {
+			sPerftWorker& victim = workers[(self + i) % count];
+			std::lock_guard<std::mutex> guard(victim.lock);
+
+			if (victim.tasks.empty())
+				continue;
+
+			if (i == 0) {
+				task = victim.tasks.back();
+				victim.tasks.pop_back();
+			}
+			else {
+				task = victim.tasks.front();
+				victim.tasks.pop_front();
+			}
+			found = true;
+		}
+
+		if (!found)
+			return;
+
+		// Walk from the worker's own copy of the root down to the subtree and back
+		for (int i = 0; i < task.length; i++)
+			board.makeMove(task.path[i]);
+
+		workers[self].nodes += Perft(board, task.depth, cache);
+
+		for (int i = 0; i < task.length; i++)
+			board.unmakeMove();
+	}
+}
+
+uint64_t ParallelPerft(const cBoard& board, int depth, int threads, int splitPly, cPerftCache* cache) {
+	if (threads <= 0)
+		threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+	// Task paths hold at most MAX_SPLIT_PLY moves, a split at ply 0 is the whole tree as one task
+	splitPly = std::max(0, std::min(splitPly, MAX_SPLIT_PLY));
+	cBoard root = board;
+
+	// Too shallow to be worth splitting
+	if (threads == 1 || depth <= splitPly)
+		return Perft(root, depth, cache);
+
+	std::vector<sPerftTask> tasks;
+	sPerftTask task = {};
+	task.depth = depth;
+	splitTree(root, task, splitPly, tasks);
+
+	// Deal tasks out round robin, stealing evens out subtrees of different sizes
+	std::vector<sPerftWorker> workers(threads);
+	for (size_t i = 0; i < tasks.size(); i++)
+		workers[i % threads].tasks.push_back(tasks[i]);
+
+	std::vector<std::thread> pool;
+	for (int i = 0; i < threads; i++)
+		pool.emplace_back(perftWorker, std::ref(workers), i, std::cref(root), cache);
+
+	for (auto& t : pool)
+		t.join();
+
+	// Merge per worker counters
+	uint64_t nodes = 0;
+	for (auto& w : workers)
+		nodes += w.nodes;
+
+	return nodes;
+}
+
+// ######################### REPORTING ############################## //
+
+// Prints total, elapsed time and nodes per second
+static void report(uint64_t nodes, std::chrono::steady_clock::time_point start) {
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Nodes: " << nodes << std::endl;
+	std::cout << "Time:  " << seconds << " s" << std::endl;
+	std::cout << "NPS:   " << (uint64_t)(seconds > 0 ? nodes / seconds : 0) << std::endl;
+}
+
+uint64_t RunPerft(const cBoard& board, int depth, int threads, int splitPly, size_t hashMB) {
+	auto start = std::chrono::steady_clock::now();
+
+	std::unique_ptr<cPerftCache> cache;
+	if (hashMB > 0)
+		cache.reset(new cPerftCache(hashMB));
+
+	uint64_t nodes = ParallelPerft(board, depth, threads, splitPly, cache.get());
+	report(nodes, start);
+
+	return nodes;
+}
+
+uint64_t Divide(const cBoard& root, int depth) {
+	cBoard board = root;
+	auto start = std::chrono::steady_clock::now();
+
+	sMoveList moves;
+	GenerateMoves(board, moves);
+
+	// Like Perft, the position itself is the only leaf at depth 0 and there are no root moves to split
+	if (depth <= 0)
+		moves.clear();
+
+	uint64_t total = (depth <= 0) ? 1 : 0;
+	for (Move m : moves) {
+		board.makeMove(m);
+		uint64_t nodes = Perft(board, depth - 1);
+		board.unmakeMove();
+
+		total += nodes;
+
+		std::cout << MoveToString(m) << ": " << nodes << std::endl;
+	}
+
+	std::cout << std::endl;
+	report(total, start);
+
+	return total;
+}
+
+bool PerftSuite(int threads, int splitPly, size_t hashMB) {
+	// Positions and counts from the Chess Programming Wiki perft results page
+	struct sPerftEntry {
+		const char* fen;
+		int depth;
+		uint64_t nodes;
+	};
+
+	const sPerftEntry suite[] = {
+		{ "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609 },
+		{ "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603 },
+		{ "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083 },
+		{ "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292 },
+		{ "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487 },
+		{ "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594 }
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	uint64_t total = 0;
+	bool passed = true;
+
+	// Keys include the whole position, so one cache is shared by every entry
+	std::unique_ptr<cPerftCache> cache;
+	if (hashMB > 0)
+		cache.reset(new cPerftCache(hashMB));
+
+	for (const sPerftEntry& entry : suite) {
+		cBoard board;
+		board.setFen(entry.fen);
+
+		uint64_t nodes = ParallelPerft(board, entry.depth, threads, splitPly, cache.get());
+		total += nodes;
+
+		bool match = nodes == entry.nodes;
+		passed = passed && match;
+
+		std::cout << (match ? "OK   " : "FAIL ") << "depth " << entry.depth << " " << nodes;
+		if (!match)
+			std::cout << " (expected " << entry.nodes << ")";
+		std::cout << "  " << entry.fen << std::endl;
+	}
+
+	std::cout << std::endl;
+	report(total, start);
+
+	return passed;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "Board.h"
+
+// PERFT
+// Counts the leaf nodes of the legal move tree, used to check the move generator and measure its speed
+
+// PERFT CACHE
+// Fixed size table of (key, depth, count) entries, one entry per slot and always replaced
+// Entries are written lock free, each slot keeps its check word as key ^ data so a torn write from
+// another thread never matches and is read as a miss
+class cPerftCache {
+public:
+	// Largest power of two slot count that fits in megabytes
+	cPerftCache(size_t megabytes);
+
+	bool probe(uint64_t key, int depth, uint64_t& nodes) const;
+	void store(uint64_t key, int depth, uint64_t nodes);
+
+private:
+	struct sEntry {
+		std::atomic<uint64_t> check;
+		std::atomic<uint64_t> data;		// nodes << 8 | depth
+	};
+
+	std::unique_ptr<sEntry[]> entries;
+	size_t mask;
+};
+
+// Number of leaves depth plies below board, the last ply is counted in bulk without playing the moves
+// Subtrees already counted are looked up in cache when one is given
+uint64_t Perft(cBoard& board, int depth, cPerftCache* cache = nullptr);
+
+// Perft on a work-stealing thread pool
+// Tree is split into subtrees splitPly plies below board, threads = 0 uses every hardware thread
+// All threads share one cache when given
+uint64_t ParallelPerft(const cBoard& board, int depth, int threads = 0, int splitPly = 2, cPerftCache* cache = nullptr);
+
+// Parallel perft that prints the total, time and nodes per second
+// hashMB = 0 runs without a cache
+uint64_t RunPerft(const cBoard& board, int depth, int threads = 0, int splitPly = 2, size_t hashMB = 0);
+
+// Perft split by root move, prints each move's count followed by total, time and nodes per second
+uint64_t Divide(const cBoard& board, int depth);
+
+// Runs the standard published perft positions and reports any count that does not match
+// Returns true if every position matched
+bool PerftSuite(int threads = 0, int splitPly = 2, size_t hashMB = 0);
@@ -6,992 +6,196 @@ cPiece::cPiece(int nx, int ny, int ntype) {
 	type = ntype;
 }
 
- // ######################### PAWN ##################################### //
+// ######################### PIECE TABLE ############################## //
 
-// Call base constructor to initialize first varibles
-// Additional Setup afterwards
-Pawn::Pawn(int nx, int ny, int ntype, bool fm) : cPiece(nx, ny, ntype) {
-	firstMove = fm;
-}
-
-std::vector<std::pair<int, int>> Pawn::movement(int curPlayer, int* collision, bool* checkZones = nullptr) {
-	// return movement vector
-	std::vector<std::pair<int, int>> moveLoc;
-
-	// Collision Location
-	int curPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// Some setup Variables
-	int moveUp = curPlayer == 0 ? 1 : -1;
-	int colMoveUp = (moveUp * 8) + curPos;
-
-	// Normal Movement
-	if (collision[colMoveUp] == 0) {
-		moveLoc.push_back(std::make_pair(x, y + moveUp));
+void sPieceTable::clear() {
+	for (int sq = 0; sq < 64; sq++)
+		slotOn[sq] = -1;
 
-		// Starting Movement (move up 2 spaces if no pieces in front)
-		if (firstMove && collision[colMoveUp + (8 * moveUp)] == 0)
-			moveLoc.push_back(std::make_pair(x, y + (2 * moveUp)));
-	}
-	// Valid capture zones
-	if (collision[colMoveUp - 1] == enemy || collision[colMoveUp - 1] == enemy + 2)
-		moveLoc.push_back(std::make_pair(x - 1, y + moveUp));
-	if (collision[colMoveUp + 1] == enemy || collision[colMoveUp - 1] == enemy + 2)
-		moveLoc.push_back(std::make_pair(x + 1, y + moveUp));
-
-	return moveLoc;
+	count[WHITE] = 0;
+	count[BLACK] = 0;
 }
 
-void Pawn::updateZones(int curPlayer, int* collision, bool* oldZone) {
-
-	// Quick position calc
-	int pPos = y * 8 + x;
+void sPieceTable::build(const cBoard& board) {
+	clear();
 
-	// Adjust Pawn direction depending on player
-	int direction = curPlayer == 0 ? 1 : -1;
-
-	// Left Diagonal
-	// Check Collision and Position
-	if (x != 0) {
-		if (collision[pPos + (8 * direction) - 1] != curPlayer + 1 || collision[pPos + (8 * direction) - 1] != curPlayer + 3) {
-			// Check if already true
-			if (!oldZone[pPos + (8 * direction) - 1])
-				collision[pPos + (8 * direction) - 1] = true;
-		}
-	}
-
-	// Right Diagonal
-	// Check Collision and Position
-	if (x != 7) {
-		if (collision[pPos + (8 * direction) + 1] != curPlayer + 1 || collision[pPos + (8 * direction) + 1] != curPlayer + 3) {
-			// Check if already true
-			if (!collision[pPos + (8 * direction) - 1])
-				collision[pPos + (8 * direction) - 1] = true;
-		}
+	for (Bitboard b = board.occupied; b; ) {
+		int sq = PopLsb(b);
+		add(board.colorOn(sq), board.typeOn(sq), sq);
 	}
 }
 
+void sPieceTable::add(int color, int ntype, int sq) {
+	// A player never has more than 16 pieces
+	if (count[color] == 16)
+		return;
 
+	int slot = end(color);
+	count[color]++;
 
-// ######################### ROOK ##################################### //
-// Inherits orignal constructor
-// If additional setup is needed for this piece add in
-Rook::Rook(int nx, int ny, int ntype, bool fm) : cPiece(nx, ny, ntype) {
-	firstMove = fm;
-}
-
-std::vector<std::pair<int, int>> Rook::movement(int curPlayer, int* collision, bool* checkZones = nullptr) {
-	// return movement vector
-	std::vector<std::pair<int, int>> moveLoc;
-
-	// Collision Location
-	int curPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// Check UP
-	for (int i = 1; i <= y; i++) {
-		int checkLoc = curPos - (8 * i);
-
-		// Check Collision
-		if (collision[checkLoc] == ally || collision[checkLoc] == ally + 2)
-			break;
-
-		else {
-			// Valid movement
-			moveLoc.push_back(std::make_pair(x, y - i));
-
-			// Enemy Collision
-			if (collision[checkLoc] == enemy || collision[checkLoc] == enemy + 2)
-				break;
-		}
-	}
-
-	// Check RIGHT
-	for (int i = 1; i < 8 - x; i++) {
-		int checkLoc = curPos + i;
-
-		// Check ally Collision
-		if (collision[checkLoc] == ally || collision[checkLoc] == ally + 2)
-			break;
-
-		else {
-			// Valid movement
-			moveLoc.push_back(std::make_pair(x + i, y));
-
-			// Enemy Collision
-			if (collision[checkLoc] == enemy || collision[checkLoc] == enemy + 2)
-				break;
-		}
-	}
-
-	// Check DOWN
-	for (int i = 1; i < 8 - y; i++) {
-		int checkLoc = curPos + (8 * i);
-
-		// Check Collision
-		if (collision[checkLoc] == ally || collision[checkLoc] == ally + 2)
-			break;
-
-		else {
-			// Valid movement
-			moveLoc.push_back(std::make_pair(x, y + i));
-
-			// Enemy Collision
-			if (collision[checkLoc] == enemy || collision[checkLoc] == enemy + 2)
-				break;
-		}
-	}
-
-	// Check LEFT
-	for (int i = 1; i <= x; i++) {
-		int checkLoc = curPos - i;
-
-		// Check Collision
-		if (collision[checkLoc] == ally || collision[checkLoc] == ally + 2)
-			break;
+	// King takes the first slot, whatever was there moves to the new one
+	if (ntype == KING && slot != first(color)) {
+		int base = first(color);
 
-		else {
-			// Valid Movement
-			moveLoc.push_back(std::make_pair(x - i, y));
+		type[slot] = type[base];
+		square[slot] = square[base];
+		flags[slot] = flags[base];
+		slotOn[square[slot]] = (int8_t)slot;
 
-			// Enemy Collision
-			if (collision[checkLoc] == enemy || collision[checkLoc] == enemy + 2)
-				break;
-		}
+		slot = base;
 	}
 
-	return moveLoc;
+	type[slot] = (uint8_t)ntype;
+	square[slot] = (uint8_t)sq;
+	flags[slot] = PieceCode(color, ntype) & ~CODE_TYPE;
+	slotOn[sq] = (int8_t)slot;
 }
 
-void Rook::updateZones(int curPlayer, int* collision, bool* oldZone) {
-	// Quick position calc
-	int pPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// Used to calculate position to check
-	int checkPos = 0;
-
-	// Check UP
-	for (int i = 1; i <= y; i++) {
-		checkPos = pPos - (8 * i);
-
-		// Check Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Check if Enemy
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
+// Player's last piece fills the hole so the slots stay contiguous
+void sPieceTable::remove(int sq) {
+	int slot = slotOn[sq];
 
-	// Check DOWN
-	for (int i = 1; i < 8 - y; i++) {
-		checkPos = pPos + (8 * i);
-
-		// Check Collision
-		if (collision[checkPos] == ally)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Check if Enemy
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
+	// Nothing to remove
+	if (slot < 0)
+		return;
 
-	// Check LEFT
-	for (int i = 1; i <= x; i++) {
-		checkPos = pPos - i;
-
-		// Check Collision
-		if (collision[checkPos] == ally)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Check if Enemy
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
+	int color = colorOf(slot);
+	int last = end(color) - 1;
 
-	// Check RIGHT
-	for (int i = 1; i < 8 - x; i++) {
-		checkPos = pPos + i;
-
-		// Check Collision
-		if (collision[checkPos] == ally)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Check if Enemy
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-	
+	type[slot] = type[last];
+	square[slot] = square[last];
+	flags[slot] = flags[last];
+	slotOn[square[slot]] = (int8_t)slot;
 
+	slotOn[sq] = -1;
+	count[color]--;
 }
 
+void sPieceTable::move(int from, int to) {
+	int slot = slotOn[from];
 
+	// Nothing to move
+	if (slot < 0)
+		return;
 
-// ######################### KNIGHT ################################### //
-
-// Inherits orignal constructor
-// If additional setup is needed for this piece add in
-Knight::Knight(int nx, int ny, int ntype) : cPiece(nx, ny, ntype) {};
-
-std::vector<std::pair<int, int>> Knight::movement(int curPlayer, int* collision, bool* checkZones = nullptr) {
-	// return movement vector
-	std::vector<std::pair<int, int>> moveLoc;
-
-	// Quick position calc
-	int curPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// TOP
-	if (y - 2 >= 0) {
-		// Top Left (2 Up, 1 Left == - 16 - 1)
-		if (x - 1 >= 0)
-			if (collision[curPos - 16 - 1] != ally || collision[curPos - 16 - 1] != ally + 2)
-				moveLoc.push_back(std::make_pair(x - 1, y - 2));
-		// Top Right (2 Up, 1 Right == - 16 + 1)
-		if (x + 1 < 8)
-			if (collision[curPos - 16 + 1] != ally || collision[curPos - 16 - 1] != ally + 2)
-				moveLoc.push_back(std::make_pair(x + 1, y - 2));
-	}
-
-	// RIGHT
-	if (x + 2 < 8) {
-		// Right Up (2 Right, 1 Up == + 2 - 8)
-		if (y - 1 >= 0)
-			if (collision[curPos + 2 - 8] != ally || collision[curPos - 16 - 1] != ally + 2)
-				moveLoc.push_back(std::make_pair(x + 2, y - 1));
-		// Right Down (2 Right, 1 Down == + 2 + 8)
-		if (y + 1 < 8)
-			if (collision[curPos + 2 + 8] != ally || collision[curPos - 16 - 1] != ally + 2)
-				moveLoc.push_back(std::make_pair(x + 2, y + 1));
-	}
-
-	// DOWN
-	if (y + 2 < 8) {
-		// Bottom Left (2 Down, 1 Left == + 16 - 1)
-		if (x - 1 >= 0)
-			if (collision[curPos + 16 - 1] != ally || collision[curPos - 16 - 1] != ally + 2)
-				moveLoc.push_back(std::make_pair(x - 1, y + 2));
-		// Bottom Right (2 Down, 1 Right == + 16 + 1)
-		if (x + 1 < 8)
-			if (collision[curPos + 16 + 1] != ally || collision[curPos - 16 - 1] != ally + 2)
-				moveLoc.push_back(std::make_pair(x + 1, y + 2));
-	}
-
-	// LEFT
-	if (x - 2 >= 0) {
-		// Left Up (2 Left, 1 Up == - 2 - 8)
-		if (y - 1 >= 0)
-			if (collision[curPos - 2 - 8] != ally || collision[curPos - 16 - 1] != ally + 2)
-				moveLoc.push_back(std::make_pair(x - 2, y - 1));
-		// Left Down (2 Left, 1 Down == - 2 + 8)
-		if (y + 1 < 8)
-			if (collision[curPos - 2 + 8] != ally || collision[curPos - 16 - 1] != ally + 2)
-				moveLoc.push_back(std::make_pair(x - 2, y + 1));
-	}
-
-	return moveLoc;
-}
+	remove(to);
 
-void Knight::updateZones(int curPlayer, int* collision, bool* oldZone) {
-	// Collision Location
-	int pPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	//Top
-	if (y - 2 >= 0) {
-		// Top Left (2 Up, 1 Left == - 16 - 1)
-		if (x - 1 >= 0)
-			if (collision[pPos - 16 - 1] != ally || collision[pPos - 16 - 1] != ally + 2)
-				if (!oldZone[pPos - 16 - 1])
-					oldZone[pPos - 16 - 1] = true;
-		// Top Right (2 Up, 1 Right == - 16 + 1)
-		if (x + 1 < 8)
-			if (collision[pPos - 16 + 1] != ally || collision[pPos - 16 + 1] != ally + 2)
-				if (!oldZone[pPos - 16 + 1])
-					oldZone[pPos - 16 + 1] = true;
-	}
-	// Right
-	if (x + 2 < 8) {
-		// Right Up (2 Right, 1 Up == + 2 - 8)
-		if (y - 1 >= 0)
-			if (collision[pPos + 2 - 8] != ally || collision[pPos + 2 - 8] != ally + 2)
-				if (!oldZone[pPos + 2 - 8])
-					oldZone[pPos + 2 - 8] = true;
-		// Right Down (2 Right, 1 Down == + 2 + 8)
-		if (y + 1 < 8)
-			if (collision[pPos + 2 + 8] != ally || collision[pPos + 2 + 8] != ally + 2)
-				if (!oldZone[pPos + 2 + 8])
-					oldZone[pPos + 2 + 8] = true;
-	}
-	// Bot
-	if (y + 2 < 8) {
-		// Bottom Left (2 Down, 1 Left == + 16 - 1)
-		if (x - 1 >= 0)
-			if (collision[pPos + 16 - 1] != ally || collision[pPos + 16 - 1] != ally + 2)
-				if (!oldZone[pPos + 16 - 1])
-					oldZone[pPos + 16 - 1] = true;
-		// Top Right (2 Down, 1 Right == + 16 + 1)
-		if (x + 1 < 8)
-			if (collision[pPos + 16 + 1] != ally || collision[pPos + 16 + 1] != ally + 2)
-				if (!oldZone[pPos + 16 + 1])
-					oldZone[pPos + 16 + 1] = true;
-	}
-	// Left
-	if (x - 2 >= 0) {
-		// Left Up (2 Left, 1 Up == - 2 - 8)
-		if (y - 1 >= 0)
-			if (collision[pPos - 2 - 8] != ally || collision[pPos - 2 - 8] != ally + 2)
-				if (!oldZone[pPos - 2 - 8])
-					oldZone[pPos - 2 - 8] = true;
-		// Left Down (2 Left, 1 Down == - 2 + 8)
-		if (y + 1 < 8)
-			if (collision[pPos - 2 + 8] != ally || collision[pPos - 2 + 8] != ally + 2)
-				if (!oldZone[pPos - 2 + 8])
-					oldZone[pPos - 2 + 8] = true;
-	}
+	// Removing a piece may have moved this one into another slot
+	slot = slotOn[from];
+	square[slot] = (uint8_t)to;
+	slotOn[from] = -1;
+	slotOn[to] = (int8_t)slot;
 }
 
+void sPieceTable::makeMove(Move m) {
+	int from = MoveFrom(m);
+	int to = MoveTo(m);
 
+	if (slotOn[from] < 0)
+		return;
 
-// ######################### BISHOP ################################### //
+	int up = (colorOf(slotOn[from]) == WHITE) ? 8 : -8;
 
-// Inherits orignal constructor
-// If additional setup is needed for this piece add in
-Bishop::Bishop(int nx, int ny, int ntype) : cPiece(nx, ny, ntype) {};
+	switch (MoveFlags(m)) {
+	case EN_PASSANT:
+		remove(to - up);
+		move(from, to);
+		break;
 
-std::vector<std::pair<int, int>> Bishop::movement(int curPlayer, int* collision, bool* checkZones = nullptr) {
-	// return movement vector
-	std::vector<std::pair<int, int>> moveLoc;
+	case CASTLE_KING:
+		move(from, to);
+		move(to + 1, to - 1);
+		break;
 
-	// Quick position calc
-	int curPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
+	case CASTLE_QUEEN:
+		move(from, to);
+		move(to - 2, to + 1);
+		break;
 
-	// Temp hold new position value
-	int checkPos = 0;
-	// Top Left Diagonal
-	for (int i = 1; i <= x && i <= y; i++) {
-		checkPos = curPos - (i * (8 + 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
+	default:
+		move(from, to);
 
-		else {
-			// Space is valid
-			moveLoc.push_back(std::make_pair(x - i, y - i));
-			// Enemy Collision
-			if (collision[checkPos] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
+		if (IsPromotion(m))
+			type[slotOn[to]] = (uint8_t)PromotionType(m);
 	}
-
-	// Top Right Diagonal
-	for (int i = 1; i < 8 - x && i <= y; i++) {
-		checkPos = curPos - (i * (8 - 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Space is valid
-			moveLoc.push_back(std::make_pair(x + i, y - i));
-			// Enemy Collision
-			if (collision[checkPos] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
-
-	// Bottom Left Diagonal
-	for (int i = 1; i <= x && i < 8 - y; i++) {
-		checkPos = curPos + (i * (8 - 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Space is valid
-			moveLoc.push_back(std::make_pair(x - i, y + i));
-			// Enemy Collision
-			if (collision[checkPos] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
-
-	// Bottom Right Diagonal
-	for (int i = 1; i < 8 - x && i < 8 - y; i++) {
-		checkPos = curPos + (i * (8 + 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Space is valid
-			moveLoc.push_back(std::make_pair(x + i, y + i));
-			// Enemy Collision
-			if (collision[checkPos] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
-
-	return moveLoc;
 }
 
-void Bishop::updateZones(int curPlayer, int* collision, bool* oldZone) {
-	// Collision Location
-	int pPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// Used to calculate position to check
-	int checkPos = 0;
-
-	// Top Left Diagonal
-	for (int i = 1; i <= x && i <= y; i++) {
-		checkPos = pPos - (i * (8 + 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Enemy Collision
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-
-	// Top Right Diagonal
-	for (int i = 1; i < 8 - x && i <= y; i++) {
-		checkPos = pPos - (i * (8 - 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Enemy Collision
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-
-	// Bottom Left Diagonal
-	for (int i = 1; i <= x && i < 8 - y; i++) {
-		checkPos = pPos + (i * (8 - 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Enemy Collision
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-
-	// Bottom Right Diagonal
-	for (int i = 1; i < 8 - x && i < 8 - y; i++) {
-		checkPos = pPos + (i * (8 + 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Enemy Collision
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-}
-
-
-
-// ######################### QUEEN ################################### //
-
-// Inherits orignal constructor
-// If additional setup is needed for this piece add in
-Queen::Queen(int nx, int ny, int ntype) : cPiece(nx, ny, ntype) {};
-
-std::vector<std::pair<int, int>> Queen::movement(int curPlayer, int* collision, bool* checkZones = nullptr) {
-	// return movement vector
-	std::vector<std::pair<int, int>> moveLoc;
-
-	// Collision Location
-	int curPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// Temp hold new position value
-	int checkPos = 0;
-
-	// Check UP
-	for (int i = 1; i <= y; i++) {
-		int checkLoc = curPos - (8 * i);
+// ######################### PAWN ##################################### //
 
-		// Check Collision
-		if (collision[checkLoc] == ally || collision[checkPos] == ally + 2)
-			break;
+template<int Us>
+static void pawnMoves(int sq, const cBoard& board, sMoveList& moves) {
+	constexpr int up = (Us == WHITE) ? 8 : -8;
+	constexpr int startRow = (Us == WHITE) ? 1 : 6;
 
-		else {
-			// Valid movement
-			moveLoc.push_back(std::make_pair(x, y - i));
+	Bitboard enemy = board.colors[Us ^ 1];
+	int to = sq + up;
 
-			// Enemy Collision
-			if (collision[checkLoc] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
-
-	// Top Right Diagonal
-	for (int i = 1; i < 8 - x && i <= y; i++) {
-		checkPos = curPos - (i * (8 - 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Space is valid
-			moveLoc.push_back(std::make_pair(x + i, y - i));
-			// Enemy Collision
-			if (collision[checkPos] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
+	// Pawn on last row has nowhere to go
+	if (to < 0 || to > 63)
+		return;
 
-	// Check RIGHT
-	for (int i = 1; i < 8 - x; i++) {
-		int checkLoc = curPos + i;
-
-		// Check ally Collision
-		if (collision[checkLoc] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Valid movement
-			moveLoc.push_back(std::make_pair(x + i, y));
-
-			// Enemy Collision
-			if (collision[checkLoc] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
-
-	// Bottom Right Diagonal
-	for (int i = 1; i < 8 - x && i < 8 - y; i++) {
-		checkPos = curPos + (i * (8 + 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Space is valid
-			moveLoc.push_back(std::make_pair(x + i, y + i));
-			// Enemy Collision
-			if (collision[checkPos] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
-
-	// Check DOWN
-	for (int i = 1; i < 8 - y; i++) {
-		int checkLoc = curPos + (8 * i);
-
-		// Check Collision
-		if (collision[checkLoc] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Valid movement
-			moveLoc.push_back(std::make_pair(x, y + i));
-
-			// Enemy Collision
-			if (collision[checkLoc] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
+	// Normal Movement (promotes on the last row)
+	if (!(board.occupied & SquareBB(to))) {
+		AddPawnMove(moves, sq, to, false);
 
-	// Bottom Left Diagonal
-	for (int i = 1; i <= x && i < 8 - y; i++) {
-		checkPos = curPos + (i * (8 - 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Space is valid
-			moveLoc.push_back(std::make_pair(x - i, y + i));
-			// Enemy Collision
-			if (collision[checkPos] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
-
-	// Check LEFT
-	for (int i = 1; i <= x; i++) {
-		int checkLoc = curPos - i;
-
-		// Check Collision
-		if (collision[checkLoc] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Valid Movement
-			moveLoc.push_back(std::make_pair(x - i, y));
-
-			// Enemy Collision
-			if (collision[checkLoc] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
+		// Starting Movement (move up 2 spaces if no pieces in front)
+		if ((sq >> 3) == startRow && !(board.occupied & SquareBB(to + up)))
+			moves.add(MakeMove(sq, to + up, DOUBLE_PUSH));
 	}
 
-	// Top Left Diagonal
-	for (int i = 1; i <= x && i <= y; i++) {
-		checkPos = curPos - (i * (8 + 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Space is valid
-			moveLoc.push_back(std::make_pair(x - i, y - i));
-			// Enemy Collision
-			if (collision[checkPos] == enemy || collision[checkPos] == enemy + 2)
-				break;
-		}
-	}
+	// Valid capture zones
+	Bitboard captures = PawnAttacks(Us, sq) & enemy;
+	while (captures)
+		AddPawnMove(moves, sq, PopLsb(captures), true);
 
-	return moveLoc;
+	// En passant onto the square a pawn just skipped
+	if (board.epSquare >= 0 && (PawnAttacks(Us, sq) & SquareBB(board.epSquare)))
+		moves.add(MakeMove(sq, board.epSquare, EN_PASSANT));
 }
 
-void Queen::updateZones(int curPlayer, int* collision, bool* oldZone) {
-	// Collision Location
-	int pPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// Used to calculate position to check
-	int checkPos = 0;
-
-	// Check UP
-	for (int i = 1; i <= y; i++) {
-		checkPos = pPos - (8 * i);
-
-		// Check Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Check if Enemy
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
+// ######################### PIECES ################################### //
 
-	// Top Right Diagonal
-	for (int i = 1; i < 8 - x && i <= y; i++) {
-		checkPos = pPos - (i * (8 - 1));
-
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Enemy Collision
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
+void PieceMoves(int type, int color, int sq, const cBoard& board, Bitboard checkZones, sMoveList& moves) {
+	Bitboard ally = board.colors[color];
+	Bitboard enemy = board.colors[color ^ 1];
 
-	// Check RIGHT
-	for (int i = 1; i < 8 - x; i++) {
-		checkPos = pPos + i;
-
-		// Check Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Check if Enemy
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
+	switch (type) {
+	case PAWN:
+		if (color == WHITE)
+			pawnMoves<WHITE>(sq, board, moves);
+		else
+			pawnMoves<BLACK>(sq, board, moves);
+		break;
 
-	// Bottom Right Diagonal
-	for (int i = 1; i < 8 - x && i < 8 - y; i++) {
-		checkPos = pPos + (i * (8 + 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Enemy Collision
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
+	// Lines and diagonals up to and including the first blocker, minus allies
+	case ROOK:
+		AddMoves(moves, sq, RookAttacks(sq, board.occupied) & ~ally, enemy);
+		break;
 
-	// Check DOWN
-	for (int i = 1; i < 8 - y; i++) {
-		checkPos = pPos + (8 * i);
-
-		// Check Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Check if Enemy
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-
-	// Bottom Left Diagonal
-	for (int i = 1; i <= x && i < 8 - y; i++) {
-		checkPos = pPos + (i * (8 - 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Enemy Collision
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-
-	// Check LEFT
-	for (int i = 1; i <= x; i++) {
-		checkPos = pPos - i;
-
-		// Check Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Check if Enemy
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-
-	// Top Left Diagonal
-	for (int i = 1; i <= x && i <= y; i++) {
-		checkPos = pPos - (i * (8 + 1));
-		//Check for Ally Collision
-		if (collision[checkPos] == ally || collision[checkPos] == ally + 2)
-			break;
-
-		else {
-			// Check if already true
-			if (!oldZone[checkPos])
-				oldZone[checkPos] = true;
-			// Enemy Collision
-			if (collision[checkPos] == enemy)
-				break;
-		}
-	}
-}
+	case BISHOP:
+		AddMoves(moves, sq, BishopAttacks(sq, board.occupied) & ~ally, enemy);
+		break;
 
+	case QUEEN:
+		AddMoves(moves, sq, QueenAttacks(sq, board.occupied) & ~ally, enemy);
+		break;
 
+	// All 8 jumps, minus allies
+	case KNIGHT:
+		AddMoves(moves, sq, KnightAttacks(sq) & ~ally, enemy);
+		break;
 
-// ######################### KING ################################### //
-// Call base constructor to initialize first varibles
-// Additional Setup afterwards
-King::King(int nx, int ny, int ntype, bool fm, bool cL, bool cR) : cPiece(nx, ny, ntype) {
-	firstMove = fm;
-	castleL = cL;
-	castleR = cR;
-}
+	// Neighbours that are neither allies nor attacked
+	// Castling is offered while the right stands, whether the path is clear and safe is left to IsLegal
+	case KING:
+		AddMoves(moves, sq, KingAttacks(sq) & ~(ally | checkZones), enemy);
 
-std::vector<std::pair<int, int>> King::movement(int curPlayer, int* collision, bool* checkZones) {
-	// return movement vector
-	std::vector<std::pair<int, int>> moveLoc;
-
-	// Collision Location
-	int pPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// Used to calculate position to check
-	int checkPos = 0;
-
-	// Check Up
-	checkPos = pPos - 8;
-	if (y - 1 >= 0)
-		if (collision[checkPos] != ally && !checkZones[checkPos])
-			moveLoc.push_back(std::make_pair(x, y - 1));
-
-	// Check Up Right
-	checkPos = checkPos + 1;
-	if (x + 1 < 8 && y - 1 >= 0)
-		if (collision[checkPos] != ally && !checkZones[checkPos])
-			moveLoc.push_back(std::make_pair(x + 1, y - 1));
-
-	// Check Right
-	checkPos = checkPos + 8;
-	if (x + 1 < 8)
-		if (collision[checkPos] != ally && !checkZones[checkPos])
-			moveLoc.push_back(std::make_pair(x + 1, y));
-
-	// Check Down Right
-	checkPos = checkPos + 8;
-	if (x + 1 < 8 && y + 1 < 8)
-		if (collision[checkPos] != ally && !checkZones[checkPos])
-			moveLoc.push_back(std::make_pair(x + 1, y + 1));
-
-	// Check Down
-	checkPos = checkPos - 1;
-	if (y + 1 < 8)
-		if (collision[checkPos] != ally && !checkZones[checkPos])
-			moveLoc.push_back(std::make_pair(x, y + 1));
-
-	// Check Down Left
-	checkPos = checkPos - 1;
-	if (x - 1 >= 0 && y + 1 < 8)
-		if (collision[checkPos] != ally && !checkZones[checkPos])
-			moveLoc.push_back(std::make_pair(x - 1, y + 1));
-
-	// Check Left
-	checkPos = checkPos - 8;
-	if (x - 1 >= 0)
-		if (collision[checkPos] != ally && !checkZones[checkPos])
-			moveLoc.push_back(std::make_pair(x - 1, y));
-
-	// Check Up Left
-	checkPos = checkPos - 8;
-	if (x - 1 >= 0 && y - 1 >= 0)
-		if (collision[checkPos] != ally && !checkZones[checkPos])
-			moveLoc.push_back(std::make_pair(x - 1, y - 1));
-
-
-	// Castling Movement
-	if (firstMove) {
-		if (castleL) {
-			
-		}
-
-		if (castleR) {
-			
+		if (sq == ((color == WHITE) ? 4 : 60)) {
+			if (board.castleRights & ((color == WHITE) ? WHITE_OO : BLACK_OO))
+				moves.add(MakeMove(sq, sq + 2, CASTLE_KING));
+			if (board.castleRights & ((color == WHITE) ? WHITE_OOO : BLACK_OOO))
+				moves.add(MakeMove(sq, sq - 2, CASTLE_QUEEN));
 		}
+		break;
 	}
-
-	return moveLoc;
-}
-
-void King::updateZones(int curPlayer, int* collision, bool* oldZone) {
-	// Collision Location
-	int pPos = y * 8 + x;
-	int enemy = curPlayer == 0 ? 2 : 1;
-	int ally = curPlayer + 1;
-
-	// Used to calculate position to check
-	int checkPos = 0;
-
-	// Check Up
-	checkPos = pPos - 8;
-	if (y - 1 >= 0)
-		if (collision[checkPos] != ally && !oldZone[checkPos])
-			oldZone[checkPos] = true;
-
-	// Check Up Right
-	checkPos = checkPos + 1;
-	if (x + 1 < 8 && y - 1 >= 0)
-		if (collision[checkPos] != ally && !oldZone[checkPos])
-			oldZone[checkPos] = true;
-
-	// Check Right
-	checkPos = checkPos + 8;
-	if (x + 1 < 8)
-		if (collision[checkPos] != ally && !oldZone[checkPos])
-			oldZone[checkPos] = true;
-
-	// Check Down Right
-	checkPos = checkPos + 8;
-	if (x + 1 < 8 && y + 1 < 8)
-		if (collision[checkPos] != ally && !oldZone[checkPos])
-			oldZone[checkPos] = true;
-
-	// Check Down
-	checkPos = checkPos - 1;
-	if (y + 1 < 8)
-		if (collision[checkPos] != ally && !oldZone[checkPos])
-			oldZone[checkPos] = true;
-
-	// Check Down Left
-	checkPos = checkPos - 1;
-	if (x - 1 >= 0 && y + 1 < 8)
-		if (collision[checkPos] != ally && !oldZone[checkPos])
-			oldZone[checkPos] = true;
-
-	// Check Left
-	checkPos = checkPos - 8;
-	if (x - 1 >= 0)
-		if (collision[checkPos] != ally && !oldZone[checkPos])
-			oldZone[checkPos] = true;
-
-	// Check Up Left
-	checkPos = checkPos - 8;
-	if (x - 1 >= 0 && y - 1 >= 0)
-		if (collision[checkPos] != ally && !oldZone[checkPos])
-			oldZone[checkPos] = true;
 }
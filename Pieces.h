@@ -1,9 +1,13 @@
 #pragma once
 
-#include <vector>
+#include "Board.h"
 
-// BASE CLASS
-// All chess pieces will be inheriting from this class
+// Pseudo-legal moves of a piece of type and color on sq, picked by a switch on type, including castling and en passant
+// King steps into checkZones are dropped, the other pieces ignore it, IsLegal tells which of the rest can be played
+void PieceMoves(int type, int color, int sq, const cBoard& board, Bitboard checkZones, sMoveList& moves);
+
+// PIECE
+// Plain piece data, moves come from PieceMoves so no call goes through a vtable
 class cPiece {
 public:
 	int x;
@@ -13,79 +17,37 @@ public:
 	// Constructor
 	cPiece(int nx, int ny, int ntype);
 
-	// Override functions
-	virtual std::vector<std::pair<int, int>> movement(int curPlayer, int* collision, bool* checkZones) { return {std::make_pair(1, 1)}; };
-	virtual void updateZones(int curPlayer, int* collision, bool* oldZone) {};
+	// Adds the moves this piece can make on the board to moves
+	void movement(int curPlayer, const cBoard& board, Bitboard checkZones, sMoveList& moves) const {
+		PieceMoves(type, curPlayer, y * 8 + x, board, checkZones, moves);
+	}
 };
 
-class Pawn : public cPiece {
-
-	bool firstMove;
-public:
-	// Additional constructor setup
-	Pawn(int nx, int ny, int ntype, bool fm = false);
+// PIECE TABLE
+// Fixed capacity structure of arrays, slots 0 - 15 belong to White and 16 - 31 to Black
+// Each player's king is kept in its first slot, slotOn maps a square back to its slot (-1 if empty)
+const int MAX_PIECES = 32;
 
-protected:
-	std::vector<std::pair<int, int>> movement(int curPlayer, int* collision, bool* checkZones) override;
-	void updateZones(int curPlayer, int* collision, bool* oldZone) override;
-};
+struct sPieceTable {
+	uint8_t type[MAX_PIECES];
+	uint8_t square[MAX_PIECES];
+	uint8_t flags[MAX_PIECES];		// Color and king bits of the piece code
+	int8_t slotOn[64];
+	int count[2];
 
-class Rook : public cPiece {
-public:
-	bool firstMove;
+	void clear();
+	void build(const cBoard& board);
 
-	// Additional constructor setup
-	Rook(int nx, int ny, int ntype, bool fm = false);
+	void add(int color, int type, int sq);
+	void remove(int sq);
+	void move(int from, int to);
 
-protected:
-	std::vector<std::pair<int, int>> movement(int curPlayer, int* collision, bool* checkZones) override;
-	void updateZones(int curPlayer, int* collision, bool* oldZone) override;
-};
+	// Mirrors cBoard::makeMove, must be called before the board plays the move
+	void makeMove(Move m);
 
-class Knight : public cPiece {
-public:
-	// Constructor
-	Knight(int nx, int ny, int ntype);
+	int first(int color) const { return color * 16; }
+	int end(int color) const { return color * 16 + count[color]; }
+	int colorOf(int slot) const { return (flags[slot] & CODE_BLACK) ? BLACK : WHITE; }
 
-protected:
-	std::vector<std::pair<int, int>> movement(int curPlayer, int* collision, bool* checkZones) override;
-	void updateZones(int curPlayer, int* collision, bool* oldZone) override;
+	cPiece piece(int slot) const { return cPiece(square[slot] & 7, square[slot] >> 3, type[slot]); }
 };
-
-class Bishop : public cPiece {
-public:
-	// Constructor
-	Bishop(int nx, int ny, int ntype);
-
-protected:
-	std::vector<std::pair<int, int>> movement(int curPlayer, int* collision, bool* checkZones) override;
-	void updateZones(int curPlayer, int* collision, bool* oldZone) override;
-};
-
-class Queen : public cPiece {
-public:
-	// Constructor
-	Queen(int nx, int ny, int ntype);
-
-protected:
-	std::vector<std::pair<int, int>> movement(int curPlayer, int* collision, bool* checkZones) override;
-	void updateZones(int curPlayer, int* collision, bool* oldZone) override;
-};
-
-class King : public cPiece {
-	// Used for Castling
-	bool firstMove;
-	bool castleL = true;
-	bool castleR = true;
-
-public:
-	// Additional constructor setup
-	King(int nx, int ny, int ntype, bool fm = false, bool cL = false, bool cR = false);
-
-protected:
-	// Polymorph
-	std::vector<std::pair<int, int>> movement(int curPlayer, int* collision, bool* checkZones) override;
-	void updateZones(int curPlayer, int* collision, bool* oldZone) override;
-
-	// Additional functions
-};
\ No newline at end of file
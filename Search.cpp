@@ -0,0 +1,372 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include "Search.h"
+#include "Evaluate.h"
+#include "MovePicker.h"
+
+// Nodes searched between clock reads
+const uint64_t TIME_CHECK_NODES = 2048;
+
+// Positional swing a capture may bring on top of the material it wins, used by delta pruning
+const int DELTA_MARGIN = 200;
+
+// Mate scores are stored relative to the node so they stay right when reached from another ply
+static int scoreToTT(int score, int ply) {
+	return (score > MATE_BOUND) ? score + ply : (score < -MATE_BOUND) ? score - ply : score;
+}
+
+static int scoreFromTT(int score, int ply) {
+	return (score > MATE_BOUND) ? score - ply : (score < -MATE_BOUND) ? score + ply : score;
+}
+
+double cSearch::elapsed() const {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// First iteration always finishes so there is a move to play
+// Only the main thread watches the clock
+void cSearch::checkTime() {
+	if (threadIndex == 0 && limits.timeMs > 0 && rootDepth > 1 && elapsed() * 1000 >= limits.timeMs)
+		stop->store(true, std::memory_order_relaxed);
+}
+
+// Helper depth staggering, helper i skips depths in a pattern of its own so not every thread works on the same iteration
+static const int skipSize[16] = { 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4 };
+static const int skipPhase[16] = { 0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3 };
+
+bool cSearch::skipDepth(int depth) const {
+	if (threadIndex == 0)
+		return false;
+
+	int i = (threadIndex - 1) % 16;
+	return ((depth + skipPhase[i]) / skipSize[i]) % 2 != 0;
+}
+
+// History values stay within +-HISTORY_MAX, each update pulls harder toward zero the closer it already is to the bound
+const int HISTORY_MAX = 16384;
+
+// Killers only hold for this search, history is halved so older results count less
+void cSearch::clearOrdering() {
+	for (int ply = 0; ply < MAX_PLY; ply++)
+		killers[ply][0] = killers[ply][1] = NO_MOVE;
+
+	for (int c = 0; c < 2; c++)
+		for (int from = 0; from < 64; from++)
+			for (int to = 0; to < 64; to++)
+				history[c][from][to] /= 2;
+}
+
+void cSearch::updateHistory(int color, Move m, int bonus) {
+	int16_t& h = history[color][MoveFrom(m)][MoveTo(m)];
+	h += bonus - h * abs(bonus) / HISTORY_MAX;
+}
+
+uint64_t cSearch::totalNodes() const {
+	uint64_t total = nodes.load(std::memory_order_relaxed);
+
+	for (const auto& helper : helpers)
+		total += helper->nodes.load(std::memory_order_relaxed);
+
+	return total;
+}
+
+// A quiet move caused a cutoff, it becomes a killer and counter move and gains history, the quiets tried before it lose as much
+void cSearch::updateQuiets(int color, int ply, Move prevMove, Move best, const Move* tried, int triedCount, int depth) {
+	if (killers[ply][0] != best) {
+		killers[ply][1] = killers[ply][0];
+		killers[ply][0] = best;
+	}
+
+	if (prevMove != NO_MOVE)
+		counterMoves[MoveFrom(prevMove)][MoveTo(prevMove)] = best;
+
+	int bonus = std::min(depth * depth, 400);
+	updateHistory(color, best, bonus);
+	for (int i = 0; i < triedCount; i++)
+		updateHistory(color, tried[i], -bonus);
+}
+
+// Only this thread writes its count, a plain load and store avoids a locked add
+void cSearch::countNode() {
+	uint64_t count = nodes.load(std::memory_order_relaxed) + 1;
+	nodes.store(count, std::memory_order_relaxed);
+
+	if ((count % TIME_CHECK_NODES) == 0)
+		checkTime();
+}
+
+int cSearch::quiescence(cBoard& board, int alpha, int beta, int ply) {
+	pvLength[ply] = ply;
+	countNode();
+
+	if (stopped())
+		return 0;
+
+	if (board.isDraw(1))
+		return 0;
+
+	if (ply >= MAX_PLY - 1)
+		return Evaluate(board);
+
+	// Side to move may stand pat on the static score unless in check, where every evasion has to be looked at
+	bool inCheck = board.inCheck();
+	int standPat = -INFINITE_SCORE;
+
+	if (!inCheck) {
+		standPat = Evaluate(board);
+		if (standPat >= beta)
+			return standPat;
+		if (standPat > alpha)
+			alpha = standPat;
+	}
+
+	int best = standPat;
+	int legal = 0;
+	Move m;
+
+	cMovePicker picker = inCheck ? cMovePicker(board, NO_MOVE) : cMovePicker(board);
+
+	while ((m = picker.next()) != NO_MOVE) {
+		legal++;
+
+		if (!inCheck && !IsPromotion(m)) {
+			// Delta pruning, even winning the captured piece for free cannot bring the score up to alpha
+			int victim = (MoveFlags(m) == EN_PASSANT) ? PAWN : board.typeOn(MoveTo(m));
+			if (standPat + PieceValue[victim] + DELTA_MARGIN <= alpha)
+				continue;
+
+			// Captures that lose material once the exchange is played out
+			if (!board.seeGE(m, 0))
+				continue;
+		}
+
+		board.makeMove(m);
+		int score = -quiescence(board, -beta, -alpha, ply + 1);
+		board.unmakeMove();
+
+		if (stopped())
+			return 0;
+
+		if (score > best) {
+			best = score;
+
+			if (score > alpha) {
+				alpha = score;
+				if (alpha >= beta)
+					break;
+			}
+		}
+	}
+
+	// Checkmate, only known when in check since not every move is looked at otherwise
+	if (inCheck && legal == 0)
+		return -MATE + ply;
+
+	return best;
+}
+
+int cSearch::negamax(cBoard& board, int depth, int alpha, int beta, int ply) {
+	if (depth <= 0)
+		return quiescence(board, alpha, beta, ply);
+
+	pvLength[ply] = ply;
+	countNode();
+
+	if (stopped())
+		return 0;
+
+	// A position repeated once inside the tree is scored as the draw it can be forced into
+	if (ply > 0 && board.isDraw(1))
+		return 0;
+
+	if (ply >= MAX_PLY - 1)
+		return Evaluate(board);
+
+	// Deep enough results from the table settle the node without a search, except at the root
+	Move hashMove = NO_MOVE;
+	sTTHit hit;
+
+	if (tt && tt->probe(board.key, hit)) {
+		hashMove = hit.move;
+		int score = scoreFromTT(hit.score, ply);
+
+		if (ply > 0 && hit.depth >= depth
+			&& (hit.bound == BOUND_EXACT
+				|| (hit.bound == BOUND_LOWER && score >= beta)
+				|| (hit.bound == BOUND_UPPER && score <= alpha)))
+			return score;
+	}
+
+	// Root tries the best move of the last iteration first
+	if (ply == 0 && pv[0][0] != NO_MOVE)
+		hashMove = pv[0][0];
+
+	int us = board.sideToMove;
+	Move prevMove = (ply > 0) ? moveStack[ply - 1] : NO_MOVE;
+	Move counter = (prevMove != NO_MOVE) ? counterMoves[MoveFrom(prevMove)][MoveTo(prevMove)] : NO_MOVE;
+
+	cMovePicker picker(board, hashMove, killers[ply], counter, history[us]);
+
+	int alphaStart = alpha;
+	Move bestMove = NO_MOVE;
+	int legal = 0;
+	Move m;
+
+	// Quiets searched so far, the ones that did not cut off lose history when a later one does
+	Move quiets[MAX_MOVES];
+	int quietCount = 0;
+
+	while ((m = picker.next()) != NO_MOVE) {
+		legal++;
+
+		moveStack[ply] = m;
+		board.makeMove(m);
+		int score = -negamax(board, depth - 1, -beta, -alpha, ply + 1);
+		board.unmakeMove();
+
+		if (stopped())
+			return 0;
+
+		if (score > alpha) {
+			alpha = score;
+			bestMove = m;
+
+			// Best line is this move followed by the best line of the child
+			pv[ply][ply] = m;
+			for (int i = ply + 1; i < pvLength[ply + 1]; i++)
+				pv[ply][i] = pv[ply + 1][i];
+			pvLength[ply] = pvLength[ply + 1];
+
+			if (alpha >= beta) {
+				if (!IsCapture(m) && !IsPromotion(m))
+					updateQuiets(us, ply, prevMove, m, quiets, quietCount, depth);
+				break;
+			}
+		}
+
+		if (!IsCapture(m) && !IsPromotion(m))
+			quiets[quietCount++] = m;
+	}
+
+	// No legal move, checkmate or stalemate
+	if (legal == 0)
+		return board.inCheck() ? -MATE + ply : 0;
+
+	if (tt) {
+		int bound = (alpha >= beta) ? BOUND_LOWER : (alpha > alphaStart) ? BOUND_EXACT : BOUND_UPPER;
+		tt->store(board.key, bestMove, scoreToTT(alpha, ply), depth, bound);
+	}
+
+	return alpha;
+}
+
+sSearchResult cSearch::iterate(cBoard& board, bool verbose) {
+	sSearchResult result;
+
+	pv[0][0] = NO_MOVE;
+	pvLength[0] = 0;
+
+	for (rootDepth = 1; rootDepth <= limits.depth && rootDepth < MAX_PLY; rootDepth++) {
+		if (skipDepth(rootDepth))
+			continue;
+
+		int score = negamax(board, rootDepth, -INFINITE_SCORE, INFINITE_SCORE, 0);
+
+		// Unfinished iteration is thrown away
+		if (stopped())
+			break;
+
+		result.best = pv[0][0];
+		result.score = score;
+		result.depth = rootDepth;
+		result.seconds = elapsed();
+
+		if (verbose) {
+			uint64_t total = totalNodes();
+
+			std::cout << "Depth " << rootDepth << "  Score " << score << "  Nodes " << total
+				<< "  NPS " << (uint64_t)(result.seconds > 0 ? total / result.seconds : 0)
+				<< "  Time " << result.seconds << " s";
+
+			// Share of the table filled by this search, in thousandths
+			if (tt)
+				std::cout << "  Hashfull " << tt->hashfull();
+
+			std::cout << "  PV";
+
+			for (int i = 0; i < pvLength[0]; i++)
+				std::cout << " " << MoveToString(pv[0][i]);
+			std::cout << std::endl;
+		}
+
+		// No point looking deeper once a mate is found, or time is nearly up
+		if (score > MATE_BOUND || score < -MATE_BOUND)
+			break;
+		if (threadIndex == 0 && limits.timeMs > 0 && result.seconds * 1000 * 2 >= limits.timeMs)
+			break;
+	}
+
+	return result;
+}
+
+sSearchResult cSearch::think(const cBoard& board, const sSearchLimits& nlimits, bool verbose) {
+	limits = nlimits;
+
+	// First iteration always runs, so a live position always gets a move
+	limits.depth = std::max(1, limits.depth);
+	start = std::chrono::steady_clock::now();
+	nodes.store(0, std::memory_order_relaxed);
+	stop->store(false, std::memory_order_relaxed);
+
+	if (tt)
+		tt->newSearch();
+
+	clearOrdering();
+
+	// Helpers are kept between searches, each gets its own copy of the board
+	int threads = (limits.threads > 1) ? limits.threads : 1;
+	helpers.resize(threads - 1);
+
+	// Every thread searches its own copy with attack tracking off, the maps are only wanted on the game board
+	std::vector<cBoard> boards(helpers.size() + 1, board);
+	for (cBoard& copy : boards)
+		copy.trackAttacks(false);
+	std::vector<sSearchResult> helperResults(helpers.size());
+	std::vector<std::thread> pool;
+
+	for (size_t i = 0; i < helpers.size(); i++) {
+		if (!helpers[i])
+			helpers[i].reset(new cSearch(tt));
+
+		cSearch& helper = *helpers[i];
+		helper.threadIndex = (int)i + 1;
+		helper.limits = limits;
+		helper.start = start;
+		helper.stop = stop;
+		helper.nodes.store(0, std::memory_order_relaxed);
+		helper.clearOrdering();
+
+		pool.emplace_back([&helper, &boards, &helperResults, i]() {
+			helperResults[i] = helper.iterate(boards[i + 1], false);
+		});
+	}
+
+	sSearchResult result = iterate(boards[0], verbose);
+
+	// Main thread is done, the helpers stop with it
+	stop->store(true, std::memory_order_relaxed);
+	for (std::thread& t : pool)
+		t.join();
+
+	// Deepest finished iteration of any thread is played
+	for (const sSearchResult& r : helperResults)
+		if (r.best != NO_MOVE && (r.depth > result.depth || (r.depth == result.depth && r.score > result.score)))
+			result = r;
+
+	result.nodes = totalNodes();
+	result.seconds = elapsed();
+
+	return result;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Board.h"
+#include "TT.h"
+
+// SEARCH
+// Negamax alpha-beta, deepened one ply at a time until the depth or time limit is reached
+
+// Scores beyond MATE_BOUND are mates, MATE - n is mate in n plies
+const int MATE = 32000;
+const int MATE_BOUND = MATE - 1000;
+const int INFINITE_SCORE = 32001;
+
+const int MAX_PLY = 128;
+
+struct sSearchLimits {
+	int depth = MAX_PLY;	// Deepest iteration, in plies, at least 1
+	int timeMs = 0;			// Stops once this much time is used, 0 for no limit
+	int threads = 1;		// Lazy SMP threads, helpers search the same root and share only the table
+};
+
+// Outcome of the last finished iteration
+struct sSearchResult {
+	Move best = NO_MOVE;
+	int score = 0;
+	int depth = 0;
+	uint64_t nodes = 0;
+	double seconds = 0;
+};
+
+// Each search thread owns one, aligned to a cache line so threads never write to the same line
+class alignas(64) cSearch {
+public:
+	// Table may be shared with other searches, no table searches without one
+	cSearch(cTransTable* table = nullptr) : tt(table), nodes(0), stop(&ownStop), ownStop(false) {}
+	void setTransTable(cTransTable* table) { tt = table; }
+
+	// Finds the best move for the side to move, board itself is never moved on
+	// Each finished iteration prints its depth, score, nodes (of every thread), nodes per second and principal variation when verbose
+	// With more than one thread the helpers stop when this search does, the deepest result of all threads is played
+	sSearchResult think(const cBoard& board, const sSearchLimits& limits, bool verbose = true);
+
+private:
+	cTransTable* tt;
+
+	sSearchLimits limits;
+	std::chrono::steady_clock::time_point start;
+	int rootDepth;
+
+	// Helpers skip some depths so threads spread over different iterations
+	int threadIndex = 0;
+
+	// Written only by the owning thread, read by the main thread for reports
+	std::atomic<uint64_t> nodes;
+
+	// Set by the main thread when time is up or it has finished, shared by every thread of a search
+	std::atomic<bool>* stop;
+	std::atomic<bool> ownStop;
+
+	// Helpers of the main thread, empty for helpers
+	std::vector<std::unique_ptr<cSearch>> helpers;
+
+	// Move ordering, kept per thread so threads never write to each other's tables
+	// Two quiet moves per ply that last caused a cutoff there
+	Move killers[MAX_PLY][2];
+	// Butterfly history [color][from][to], raised for quiets that cut off and lowered for those tried before them
+	int16_t history[2][64][64] = {};
+	// Quiet reply that refuted a move, indexed by that move's from and to
+	Move counterMoves[64][64] = {};
+	// Move made at each ply on the way to the current node
+	Move moveStack[MAX_PLY];
+
+	void clearOrdering();
+	void updateHistory(int color, Move m, int bonus);
+	void updateQuiets(int color, int ply, Move prevMove, Move best, const Move* tried, int triedCount, int depth);
+
+	// Principal variation, pv[ply] holds the best line found from that ply on
+	Move pv[MAX_PLY][MAX_PLY];
+	int pvLength[MAX_PLY];
+
+	int negamax(cBoard& board, int depth, int alpha, int beta, int ply);
+	// Searches captures and promotions only until the position is quiet, so leaves are not scored in the middle of an exchange
+	int quiescence(cBoard& board, int alpha, int beta, int ply);
+
+	// Iterative deepening loop shared by the main thread and the helpers
+	sSearchResult iterate(cBoard& board, bool verbose);
+	bool skipDepth(int depth) const;
+	uint64_t totalNodes() const;
+
+	double elapsed() const;
+	void countNode();
+	void checkTime();
+	bool stopped() const { return stop->load(std::memory_order_relaxed); }
+};
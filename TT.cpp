@@ -0,0 +1,149 @@
+#include <cstdlib>
+#include <new>
+#include "TT.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <malloc.h>
+#endif
+
+// Huge pages are 2 MB, the table is aligned to that so the kernel can back it with them
+const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+static void* alignedAlloc(size_t alignment, size_t size) {
+#if defined(_MSC_VER)
+	return _aligned_malloc(size, alignment);
+#else
+	// Size must be a multiple of the alignment
+	size = (size + alignment - 1) / alignment * alignment;
+	return aligned_alloc(alignment, size);
+#endif
+}
+
+static void alignedFree(void* p) {
+#if defined(_MSC_VER)
+	_aligned_free(p);
+#else
+	free(p);
+#endif
+}
+
+cTransTable::cTransTable(size_t megabytes, bool hugePages) {
+	count = 1;
+	while (count * 2 * sizeof(sBucket) <= megabytes * 1024 * 1024)
+		count *= 2;
+
+	size_t bytes = count * sizeof(sBucket);
+	size_t alignment = (hugePages && bytes >= HUGE_PAGE_SIZE) ? HUGE_PAGE_SIZE : alignof(sBucket);
+
+	void* memory = alignedAlloc(alignment, bytes);
+	if (!memory)
+		throw std::bad_alloc();
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+	if (hugePages)
+		madvise(memory, bytes, MADV_HUGEPAGE);
+#endif
+
+	table = static_cast<sBucket*>(memory);
+	for (size_t i = 0; i < count; i++)
+		new (&table[i]) sBucket();
+	mask = count - 1;
+	generation = 0;
+
+	clear();
+}
+
+cTransTable::~cTransTable() {
+	// Buckets only hold atomics of plain integers, nothing to destroy
+	alignedFree(table);
+}
+
+void cTransTable::clear() {
+	for (size_t i = 0; i < count; i++) {
+		for (sEntry& e : table[i].entries) {
+			e.check.store(0, std::memory_order_relaxed);
+			e.data.store(0, std::memory_order_relaxed);
+		}
+	}
+}
+
+uint64_t cTransTable::pack(Move move, int score, int depth, int bound, unsigned generation) {
+	return (uint64_t)move
+		| ((uint64_t)(uint16_t)(int16_t)score << 16)
+		| ((uint64_t)(uint8_t)depth << 32)
+		| ((uint64_t)bound << 40)
+		| ((uint64_t)generation << 42);
+}
+
+bool cTransTable::probe(uint64_t key, sTTHit& hit) const {
+	const sBucket& bucket = table[key & mask];
+
+	for (const sEntry& e : bucket.entries) {
+		uint64_t data = e.data.load(std::memory_order_relaxed);
+		uint64_t check = e.check.load(std::memory_order_relaxed);
+
+		if ((check ^ data) != key || data == 0)
+			continue;
+
+		hit.move = (Move)(data & 0xFFFF);
+		hit.score = (int16_t)(data >> 16);
+		hit.depth = (int)((data >> 32) & 0xFF);
+		hit.bound = (int)((data >> 40) & 0x3);
+		return true;
+	}
+
+	return false;
+}
+
+// Entry with the same key is updated in place, otherwise the shallowest entry from an older search is replaced
+void cTransTable::store(uint64_t key, Move move, int score, int depth, int bound) {
+	sBucket& bucket = table[key & mask];
+	sEntry* replace = &bucket.entries[0];
+	int worst = 1 << 30;
+
+	for (sEntry& e : bucket.entries) {
+		uint64_t data = e.data.load(std::memory_order_relaxed);
+		uint64_t check = e.check.load(std::memory_order_relaxed);
+
+		if ((check ^ data) == key) {
+			// Keep the old best move when the new result has none
+			if (move == NO_MOVE)
+				move = (Move)(data & 0xFFFF);
+
+			replace = &e;
+			break;
+		}
+
+		// Older searches count as 8 plies shallower per generation
+		int age = (int)((generation - (data >> 42)) & 0x3F);
+		int value = (int)((data >> 32) & 0xFF) - age * 8;
+
+		if (value < worst) {
+			worst = value;
+			replace = &e;
+		}
+	}
+
+	if (depth < 0)
+		depth = 0;
+
+	uint64_t data = pack(move, score, depth, bound, generation);
+	replace->check.store(key ^ data, std::memory_order_relaxed);
+	replace->data.store(data, std::memory_order_relaxed);
+}
+
+int cTransTable::hashfull() const {
+	int used = 0;
+	size_t sample = (count < 250) ? count : 250;
+
+	for (size_t i = 0; i < sample; i++)
+		for (const sEntry& e : table[i].entries)
+			if (e.data.load(std::memory_order_relaxed) && ((e.data.load(std::memory_order_relaxed) >> 42) & 0x3F) == generation)
+				used++;
+
+	return (int)(used * 1000 / (sample * 4));
+}
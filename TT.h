@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include "Move.h"
+
+// Kind of score an entry holds
+enum ttBound {
+	BOUND_NONE,
+	BOUND_UPPER,	// Every move failed low, the score is at most this
+	BOUND_LOWER,	// A move failed high, the score is at least this
+	BOUND_EXACT
+};
+
+// What a probe hands back
+struct sTTHit {
+	Move move;
+	int score;
+	int depth;
+	int bound;
+};
+
+// TRANSPOSITION TABLE
+// Fixed size table shared by every search thread, with no locks
+// Buckets of 4 entries fill one cache line, a key only ever lives in its own bucket
+// Each entry keeps its check word as key ^ data, so a torn write from another thread never matches and reads as a miss
+class cTransTable {
+public:
+	// Largest power of two bucket count that fits in megabytes
+	// hugePages asks Linux to back the table with transparent huge pages, elsewhere it is ignored
+	cTransTable(size_t megabytes, bool hugePages = false);
+	~cTransTable();
+
+	cTransTable(const cTransTable&) = delete;
+	cTransTable& operator=(const cTransTable&) = delete;
+
+	void clear();
+
+	// Called before every search, older entries are replaced first
+	void newSearch() { generation = (generation + 1) & 0x3F; }
+
+	bool probe(uint64_t key, sTTHit& hit) const;
+	void store(uint64_t key, Move move, int score, int depth, int bound);
+
+	// Entries used out of a thousand, sampled from the first buckets
+	int hashfull() const;
+
+private:
+	// data layout
+	//	bits 0 - 15  : move
+	//	bits 16 - 31 : score
+	//	bits 32 - 39 : depth
+	//	bits 40 - 41 : bound
+	//	bits 42 - 47 : generation
+	struct sEntry {
+		std::atomic<uint64_t> check;
+		std::atomic<uint64_t> data;
+	};
+
+	struct alignas(64) sBucket {
+		sEntry entries[4];
+	};
+
+	sBucket* table;
+	size_t count;
+	size_t mask;
+	unsigned generation;
+
+	static uint64_t pack(Move move, int score, int depth, int bound, unsigned generation);
+};